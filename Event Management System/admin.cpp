@@ -4,11 +4,12 @@
 #include "helpers.h"
 #include "user.h"
 #include "event.h"
+#include "eventservice.h"
 
 using namespace std;
 
 extern vector<User> users;
-extern vector<Event> events;
+extern EventRepository events;
 
 void adminMenu(User& admin) {
     int choice;
@@ -64,7 +65,6 @@ void adminMenu(User& admin) {
             cout << "Enter 0 at any time to cancel user creation\n\n";
 
             User newUser;
-            newUser.id = generateUserId();
 
             cout << "Enter username: ";
             cin >> newUser.username;
@@ -77,15 +77,7 @@ void adminMenu(User& admin) {
             }
 
             // Check if username exists
-            bool usernameExists = false;
-            for (const User& user : users) {
-                if (user.username == newUser.username) {
-                    usernameExists = true;
-                    break;
-                }
-            }
-
-            if (usernameExists) {
+            if (findUserByUsername(newUser.username)) {
                 cout << "Username already exists.\n";
                 pauseScreen();
                 clearScreen();
@@ -164,15 +156,18 @@ void adminMenu(User& admin) {
             }
 
             switch (roleChoice) {
-            case 1: newUser.role = "admin"; break;
-            case 2: newUser.role = "organizer"; break;
-            case 3: newUser.role = "attendee"; break;
+            case 1: newUser.role = ROLE_ADMIN; break;
+            case 2: newUser.role = ROLE_ORGANIZER; break;
+            case 3: newUser.role = ROLE_ATTENDEE; break;
             }
 
-            users.push_back(newUser);
-            saveUsersToFile(users);
-
-            cout << "\nUser added successfully!\n";
+            ServiceResult result = EventService(events).registerUser(newUser);
+            if (result.ok()) {
+                cout << "\nUser added successfully!\n";
+            }
+            else {
+                cout << "\nUser not added: " << result.message << ".\n";
+            }
             pauseScreen();
             clearScreen();
             break;
@@ -202,39 +197,21 @@ void adminMenu(User& admin) {
             }
            
 
-            bool found = false;
-            for (auto it = users.begin(); it != users.end(); ++it) {
-                if (it->id == userId) {
-                    found = true;
-                    cout << "Are you sure you want to delete user " << it->username << "? (y/n): ";
-                    char confirm;
-                    cin >> confirm;
-
-                    if (tolower(confirm) == 'y') {
-                        for (auto& event : events) {
-                            if (event.organizerId == userId) {
-                                event.organizerId = -1;
-                            }
-
-                            auto attendeeIt = find(event.attendees.begin(), event.attendees.end(), userId);
-                            if (attendeeIt != event.attendees.end()) {
-                                event.attendees.erase(attendeeIt);
-                            }
-                        }
+            User* target = findUserById(userId);
+            if (target) {
+                cout << "Are you sure you want to delete user " << target->username << "? (y/n): ";
+                char confirm;
+                cin >> confirm;
 
-                        users.erase(it);
-                        saveUsersToFile(users);
-                        saveEventsToFile(events);
-                        cout << "User deleted successfully.\n";
-                    }
-                    else {
-                        cout << "Deletion canceled.\n";
-                    }
-                    break;
+                if (tolower(confirm) == 'y') {
+                    EventService(events).deleteUser(userId);
+                    cout << "User deleted successfully.\n";
+                }
+                else {
+                    cout << "Deletion canceled.\n";
                 }
             }
-
-            if (!found) {
+            else {
                 cout << "User with ID " << userId << " not found.\n";
             }
             cout << "\nPress Enter to continue...";
@@ -259,19 +236,14 @@ void adminMenu(User& admin) {
             cout << string(130, '-') << endl;
 
             for (const Event& event : events) {
-                string organizerName = "Unknown";
-                for (const User& user : users) {
-                    if (user.id == event.organizerId) {
-                        organizerName = user.name;
-                        break;
-                    }
-                }
+                const User* owner = findUserById(event.organizerId);
+                string organizerName = owner ? owner->name : "Unknown";
 
                 cout << setw(5) << event.id
                     << setw(25) << (event.title.length() > 20 ? event.title.substr(0, 20) + "..." : event.title)
-                    << setw(12) << event.date
-                    << setw(10) << event.time
-                    << setw(20) << (event.location.length() > 15 ? event.location.substr(0, 15) + "..." : event.location)
+                    << setw(12) << event.dateText()
+                    << setw(10) << event.timeText()
+                    << setw(20) << (event.location.str().length() > 15 ? event.location.str().substr(0, 15) + "..." : event.location)
                     << setw(12) << statusToString(event.status)
                     << setw(15) << (organizerName.length() > 12 ? organizerName.substr(0, 12) + "..." : organizerName) << setw(10) << event.attendees.size() << endl;
             }
@@ -285,64 +257,52 @@ void adminMenu(User& admin) {
             }
 
             if (eventId != 0) {
-                bool found = false;
-                for (const Event& event : events) {
-                    if (event.id == eventId) {
-                        found = true;
-                        clearScreen();
-                        cout << "===== EVENT DETAILS =====\n\n";
-                        cout << "Title: " << event.title << endl;
-                        cout << "Description: " << event.description << endl;
-                        cout << "Date: " << event.date << endl;
-                        cout << "Time: " << event.time << endl;
-                        cout << "Location: " << event.location << endl;
-
-                        string organizerName = "Unknown";
-                        for (const User& user : users) {
-                            if (user.id == event.organizerId) {
-                                organizerName = user.name;
-                                break;
-                            }
-                        }
-                        cout << "Organizer: " << organizerName << endl;
-                        cout << "Expected Participants: " << event.expectedParticipants << endl;
-                        cout << "Current Attendees: " << event.attendees.size() << endl;
-
-                        // theme details
-                        if (event.themeName != "None") {
-                            cout << "Theme: " << event.themeName << endl;
-                            cout << "Vendor: " << event.vendorName << endl;
-                            cout << "Theme Cost: RM" << fixed << setprecision(2) << event.themeCost << endl;
-                        }
+                const Event* match = events.find(eventId);
+                if (match) {
+                    const Event& event = *match;
+                    clearScreen();
+                    cout << "===== EVENT DETAILS =====\n\n";
+                    cout << "Title: " << event.title << endl;
+                    cout << "Description: " << event.description << endl;
+                    cout << "Date: " << event.dateText() << endl;
+                    cout << "Time: " << event.timeText() << endl;
+                    cout << "Location: " << event.location << endl;
+
+                    const User* owner = findUserById(event.organizerId);
+                    string organizerName = owner ? owner->name : "Unknown";
+                    cout << "Organizer: " << organizerName << endl;
+                    cout << "Expected Participants: " << event.expectedParticipants << endl;
+                    cout << "Current Attendees: " << event.attendees.size() << endl;
+
+                    // theme details
+                    if (event.themeName != "None") {
+                        cout << "Theme: " << event.themeName << endl;
+                        cout << "Vendor: " << event.vendorName << endl;
+                        cout << "Theme Cost: RM" << fixed << setprecision(2) << event.themeCost << endl;
+                    }
 
-                        // advertisement
-                        if (!event.marketing.empty()) {
-                            cout << "\n*** Advertisement ***\n";
-                            cout << event.marketing << endl;
-                            cout << "*********************\n";
-                        }
+                    // advertisement
+                    if (!event.marketing.empty()) {
+                        cout << "\n*** Advertisement ***\n";
+                        cout << event.marketing << endl;
+                        cout << "*********************\n";
+                    }
 
-                        // attendees list
-                        if (!event.attendees.empty()) {
-                            cout << "\nAttendees List:\n";
-                            cout << setw(5) << "ID" << setw(20) << "Name" << setw(25) << "Email" << endl;
-                            cout << string(60, '-') << endl;
-                            for (int userId : event.attendees) {
-                                for (const User& user : users) {
-                                    if (user.id == userId) {
-                                        cout << setw(5) << user.id
-                                            << setw(20) << user.name
-                                            << setw(25) << user.email << endl;
-                                        break;
-                                    }
-                                }
+                    // attendees list
+                    if (!event.attendees.empty()) {
+                        cout << "\nAttendees List:\n";
+                        cout << setw(5) << "ID" << setw(20) << "Name" << setw(25) << "Email" << endl;
+                        cout << string(60, '-') << endl;
+                        for (int userId : event.attendees) {
+                            if (const User* user = findUserById(userId)) {
+                                cout << setw(5) << user->id
+                                    << setw(20) << user->name
+                                    << setw(25) << user->email << endl;
                             }
                         }
-                        break;
                     }
                 }
-
-                if (!found) {
+                else {
                     cout << "Event not found.\n";
                 }
                 pauseScreen();
@@ -366,19 +326,14 @@ void adminMenu(User& admin) {
             cout << string(95, '-') << endl;
 
             for (const Event& event : events) {
-                string organizerName = "Unknown";
-                for (const User& user : users) {
-                    if (user.id == event.organizerId) {
-                        organizerName = user.name;
-                        break;
-                    }
-                }
+                const User* owner = findUserById(event.organizerId);
+                string organizerName = owner ? owner->name : "Unknown";
 
                 cout << setw(5) << event.id
                     << setw(25) << (event.title.length() > 20 ? event.title.substr(0, 20) + "..." : event.title)
-                    << setw(12) << event.date
-                    << setw(10) << event.time
-                    << setw(20) << (event.location.length() > 15 ? event.location.substr(0, 15) + "..." : event.location)
+                    << setw(12) << event.dateText()
+                    << setw(10) << event.timeText()
+                    << setw(20) << (event.location.str().length() > 15 ? event.location.str().substr(0, 15) + "..." : event.location)
                     << setw(12) << statusToString(event.status)
                     << setw(15) << (organizerName.length() > 12 ? organizerName.substr(0, 12) + "..." : organizerName) << endl;
             }
@@ -393,27 +348,21 @@ void adminMenu(User& admin) {
                 break;
             }
 
-            bool found = false;
-            for (auto it = events.begin(); it != events.end(); ++it) {
-                if (it->id == eventId) {
-                    found = true;
-                    cout << "Are you sure you want to remove event '" << it->title << "'? (y/n): ";
-                    char confirm;
-                    cin >> confirm;
-
-                    if (tolower(confirm) == 'y') {
-                        events.erase(it);
-                        saveEventsToFile(events);
-                        cout << "Event removed successfully.\n";
-                    }
-                    else {
-                        cout << "Removal canceled.\n";
-                    }
-                    break;
+            const Event* match = events.find(eventId);
+            if (match) {
+                cout << "Are you sure you want to remove event '" << match->title << "'? (y/n): ";
+                char confirm;
+                cin >> confirm;
+
+                if (tolower(confirm) == 'y') {
+                    EventService(events).deleteEvent(eventId);
+                    cout << "Event removed successfully.\n";
+                }
+                else {
+                    cout << "Removal canceled.\n";
                 }
             }
-
-            if (!found) {
+            else {
                 cout << "Event with ID " << eventId << " not found.\n";
             }
 
@@ -427,42 +376,27 @@ void adminMenu(User& admin) {
             clearScreen();
             cout << "===== SYSTEM STATISTICS =====\n\n";
 
-            int adminCount = 0, organizerCount = 0, attendeeCount = 0;
-            for (const User& user : users) {
-                if (user.role == "admin") adminCount++;
-                else if (user.role == "organizer") organizerCount++;
-                else if (user.role == "attendee") attendeeCount++;
-            }
+            UserCounts roles = userCountsByRole();
+            CatalogueStats stats = events.stats();
 
             cout << "Total Users: " << users.size() << endl;
-            cout << " - Admins: " << adminCount << endl;
-            cout << " - Organizers: " << organizerCount << endl;
-            cout << " - Attendees: " << attendeeCount << endl;
-            cout << "\nTotal Events: " << events.size() << endl;
-
-            if (!events.empty()) {
-                size_t totalAttendees = 0;
-                for (const Event& event : events) {
-                    totalAttendees += event.attendees.size();
-                }
-                double avgAttendees = static_cast<double>(totalAttendees) / events.size();
+            cout << " - Admins: " << roles.admins << endl;
+            cout << " - Organizers: " << roles.organizers << endl;
+            cout << " - Attendees: " << roles.attendees << endl;
+            cout << "\nTotal Events: " << stats.events << endl;
+
+            if (stats.events > 0) {
+                double avgAttendees = static_cast<double>(stats.attendees) / stats.events;
                 cout << "Average attendees per event: " << fixed << setprecision(1) << avgAttendees << endl;
             }
-            int upcomingCount = 0, ongoingCount = 0, completedCount = 0, cancelledCount = 0;
-            for (const Event& event : events) {
-                switch (event.status) {
-                case EventStatus::UPCOMING: upcomingCount++; break;
-                case EventStatus::ONGOING: ongoingCount++; break;
-                case EventStatus::COMPLETED: completedCount++; break;
-                case EventStatus::CANCELLED: cancelledCount++; break;
-                }
-            }
+            cout << "Total registrations: " << stats.attendees << endl;
+            cout << "Revenue from event fees: RM" << fixed << setprecision(2) << stats.revenue << endl;
 
             cout << "\nEvent Status Breakdown:\n";
-            cout << " - UPCOMING: " << upcomingCount << endl;
-            cout << " - ONGOING: " << ongoingCount << endl;
-            cout << " - COMPLETED: " << completedCount << endl;
-            cout << " - CANCELLED: " << cancelledCount << endl;
+            cout << " - UPCOMING: " << stats.byStatus[static_cast<int>(EventStatus::UPCOMING)] << endl;
+            cout << " - ONGOING: " << stats.byStatus[static_cast<int>(EventStatus::ONGOING)] << endl;
+            cout << " - COMPLETED: " << stats.byStatus[static_cast<int>(EventStatus::COMPLETED)] << endl;
+            cout << " - CANCELLED: " << stats.byStatus[static_cast<int>(EventStatus::CANCELLED)] << endl;
 
             cout << "\nPress Enter to continue...";
             cin.ignore();
@@ -485,17 +419,12 @@ void adminMenu(User& admin) {
             cout << string(80, '-') << endl;
 
             for (const Event& event : events) {
-                string organizerName = "Unknown";
-                for (const User& user : users) {
-                    if (user.id == event.organizerId) {
-                        organizerName = user.name;
-                        break;
-                    }
-                }
+                const User* owner = findUserById(event.organizerId);
+                string organizerName = owner ? owner->name : "Unknown";
 
                 cout << setw(5) << event.id
                     << setw(25) << (event.title.length() > 20 ? event.title.substr(0, 20) + "..." : event.title)
-                    << setw(12) << event.date
+                    << setw(12) << event.dateText()
                     << setw(15) << statusToString(event.status)
                     << setw(15) << (organizerName.length() > 12 ? organizerName.substr(0, 12) + "..." : organizerName) << endl;
             }
@@ -506,39 +435,35 @@ void adminMenu(User& admin) {
 
             if (eventId == 0) break;
 
-            bool found = false;
-            for (Event& event : events) {
-                if (event.id == eventId) {
-                    found = true;
-                    cout << "\nCurrent status: " << statusToString(event.status) << endl;
-                    cout << "Select new status:\n";
-                    cout << "1. UPCOMING\n";
-                    cout << "2. ONGOING\n";
-                    cout << "3. COMPLETED\n";
-                    cout << "4. CANCELLED\n";
-                    cout << "Enter choice (1-4): ";
-
-                    int statusChoice;
-                    while (!(cin >> statusChoice) || statusChoice < 1 || statusChoice > 4) {
-                        cin.clear();
-                        cin.ignore(numeric_limits<streamsize>::max(), '\n');
-                        cout << "Invalid input. Please enter 1-4: ";
-                    }
-
-                    switch (statusChoice) {
-                    case 1: event.status = EventStatus::UPCOMING; break;
-                    case 2: event.status = EventStatus::ONGOING; break;
-                    case 3: event.status = EventStatus::COMPLETED; break;
-                    case 4: event.status = EventStatus::CANCELLED; break;
-                    }
+            const Event* match = events.find(eventId);
+            if (match) {
+                cout << "\nCurrent status: " << statusToString(match->status) << endl;
+                cout << "Select new status:\n";
+                cout << "1. UPCOMING\n";
+                cout << "2. ONGOING\n";
+                cout << "3. COMPLETED\n";
+                cout << "4. CANCELLED\n";
+                cout << "Enter choice (1-4): ";
+
+                int statusChoice;
+                while (!(cin >> statusChoice) || statusChoice < 1 || statusChoice > 4) {
+                    cin.clear();
+                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                    cout << "Invalid input. Please enter 1-4: ";
+                }
 
-                    saveEventsToFile(events);
-                    cout << "Event status updated successfully!\n";
-                    break;
+                EventStatus newStatus = EventStatus::UPCOMING;
+                switch (statusChoice) {
+                case 1: newStatus = EventStatus::UPCOMING; break;
+                case 2: newStatus = EventStatus::ONGOING; break;
+                case 3: newStatus = EventStatus::COMPLETED; break;
+                case 4: newStatus = EventStatus::CANCELLED; break;
                 }
-            }
 
-            if (!found) {
+                EventService(events).setStatus(eventId, newStatus);
+                cout << "Event status updated successfully!\n";
+            }
+            else {
                 cout << "Event not found.\n";
             }
             pauseScreen();
@@ -553,9 +478,16 @@ void adminMenu(User& admin) {
                 cout << "No events available.\n";
             }
             else {
+                RatingStats overall = events.ratingStatsAll();
+                if (overall.count > 0) {
+                    cout << "All events\n";
+                    printRatingSummary(overall);
+                    cout << string(80, '=') << endl;
+                }
+
                 for (const Event& ev : events) {
                     cout << "Event ID: " << ev.id << " | " << ev.title << endl;
-                    cout << "Average Rating: " << fixed << setprecision(1) << ev.averageRating << "\n";
+                    printRatingSummary(ev.ratingStats);
 
                     if (ev.ratings.empty()) {
                         cout << "  No ratings or complaints yet.\n";
@@ -6,11 +6,12 @@
 #include "helpers.h"
 #include "user.h"
 #include "event.h"
+#include "eventservice.h"
 
 using namespace std;
 
 extern vector<User> users;
-extern vector<Event> events;
+extern EventRepository events;
 
 void attendeeMenu(User& attendee) {
     int choice;
@@ -51,15 +52,17 @@ void attendeeMenu(User& attendee) {
                 break;
             }
 
-            cout << "Filter by status:\n";
+            cout << "Filter by status or search:\n";
             cout << "1. All Events\n";
             cout << "2. UPCOMING\n";
             cout << "3. ONGOING\n";
             cout << "4. COMPLETED\n";
             cout << "5. CANCELLED\n";
-            cout << "Enter choice (1-5): ";
+            cout << "6. Search by keyword\n";
+            cout << "7. Date range\n";
+            cout << "Enter choice (1-7): ";
 
-            int filterChoice = getIntInput(1, 5);
+            int filterChoice = getIntInput(1, 7);
             EventStatus filterStatus;
             bool showAll = true;
 
@@ -80,6 +83,35 @@ void attendeeMenu(User& attendee) {
                 showAll = false;
             }
 
+            vector<const Event*> listed;
+            if (filterChoice == 6) {
+                string query;
+                cout << "Enter keywords (title, description, venue, theme or vendor): ";
+                getline(cin, query);
+                listed = events.search(query);
+            }
+            else if (filterChoice == 7) {
+                string fromInput, toInput;
+                cout << "From date (YYYY-MM-DD): ";
+                getline(cin, fromInput);
+                cout << "To date (YYYY-MM-DD): ";
+                getline(cin, toInput);
+                CalendarDay from = CalendarDay::parse(fromInput);
+                CalendarDay to = CalendarDay::parse(toInput);
+                if (from.empty() || to.empty()) {
+                    cout << "Invalid date format. Please use YYYY-MM-DD.\n";
+                    pauseScreen();
+                    break;
+                }
+                listed = events.between(from, to);
+            }
+            else if (showAll) {
+                for (const Event& event : events) listed.push_back(&event);
+            }
+            else {
+                listed = events.byStatus(filterStatus);
+            }
+
             clearScreen();
             cout << "===== BROWSE EVENTS =====\n\n";
 
@@ -88,27 +120,16 @@ void attendeeMenu(User& attendee) {
                 << setw(15) << "Organizer" << setw(10) << "Attendees" << endl;
             cout << string(120, '-') << endl;
 
-            bool hasEventsToShow = false;
-
-            for (const Event& event : events) {
-                if (!showAll && event.status != filterStatus) {
-                    continue;
-                }
-
-                hasEventsToShow = true;
-                string organizerName = "Unknown";
-                for (const User& user : users) {
-                    if (user.id == event.organizerId) {
-                        organizerName = user.name;
-                        break;
-                    }
-                }
+            for (const Event* shown : listed) {
+                const Event& event = *shown;
+                const User* owner = findUserById(event.organizerId);
+                string organizerName = owner ? owner->name : "Unknown";
 
-                bool isRegistered = find(event.attendees.begin(), event.attendees.end(), attendee.id) != event.attendees.end();
+                bool isRegistered = event.attendees.contains(attendee.id);
 
                 cout << setw(5) << event.id << setw(25) << (event.title.length() > 20 ? event.title.substr(0, 20) + "..." : event.title)
-                    << setw(12) << event.date << setw(10) << event.time
-                    << setw(20) << (event.location.length() > 15 ? event.location.substr(0, 15) + "..." : event.location)
+                    << setw(12) << event.dateText() << setw(10) << event.timeText()
+                    << setw(20) << (event.location.str().length() > 15 ? event.location.str().substr(0, 15) + "..." : event.location)
                     << setw(12) << statusToString(event.status)
                     << setw(15) << (organizerName.length() > 12 ? organizerName.substr(0, 12) + "..." : organizerName)
                     << setw(10) << event.attendees.size();
@@ -119,8 +140,8 @@ void attendeeMenu(User& attendee) {
                 cout << endl;
             }
 
-            if (!hasEventsToShow) {
-                cout << "No events match the selected filter.\n";
+            if (listed.empty()) {
+                cout << (filterChoice == 6 ? "No events match your search.\n" : "No events match the selected filter.\n");
                 pauseScreen();
                 break;
             }
@@ -131,51 +152,42 @@ void attendeeMenu(User& attendee) {
             if (eventId == 0) break;
 
           
-            bool found = false;
-            for (const Event& event : events) {
-                if (event.id == eventId) {
-                    found = true;
-                    clearScreen();
-                    cout << "===== EVENT DETAILS =====\n\n";
-                    cout << "Title: " << event.title << endl;
-                    cout << "Description: |" << event.description << endl;
-                    cout << "Date: " << event.date << endl;
-                    cout << "Time: " << event.time << endl;
-                    cout << "Location: " << event.location << endl;
-                    cout << "Status: " << statusToString(event.status) << endl;
-
-                    string organizerName = "Unknown";
-                    for (const User& user : users) {
-                        if (user.id == event.organizerId) {
-                            organizerName = user.name;
-                            break;
-                        }
-                    }
-                    cout << "Organizer: " << organizerName << endl;
-                    cout << "Attendees: " << event.attendees.size() << endl;
-
-                    if (event.status == EventStatus::COMPLETED && event.averageRating > 0) {
-                        cout << "Average Rating: " << fixed << setprecision(1) << event.averageRating  << endl;
-                    }
-
-                    if (!event.marketing.empty()) {
-                        cout << "\n*** Advertisement ***\n";
-                        cout << event.marketing << endl;
-                        cout << "*********************\n";
-                    }
+            const Event* match = events.find(eventId);
+            if (match) {
+                const Event& event = *match;
+                clearScreen();
+                cout << "===== EVENT DETAILS =====\n\n";
+                cout << "Title: " << event.title << endl;
+                cout << "Description: |" << event.description << endl;
+                cout << "Date: " << event.dateText() << endl;
+                cout << "Time: " << event.timeText() << endl;
+                cout << "Location: " << event.location << endl;
+                cout << "Status: " << statusToString(event.status) << endl;
+
+                const User* owner = findUserById(event.organizerId);
+                string organizerName = owner ? owner->name : "Unknown";
+                cout << "Organizer: " << organizerName << endl;
+                cout << "Attendees: " << event.attendees.size() << endl;
+
+                if (event.status == EventStatus::COMPLETED && event.averageRating > 0) {
+                    cout << "Average Rating: " << fixed << setprecision(1) << event.averageRating  << endl;
+                }
 
-                    bool isRegistered = find(event.attendees.begin(), event.attendees.end(), attendee.id) != event.attendees.end();
-                    if (isRegistered) {
-                        cout << "\nYou are registered for this event.\n";
-                    }
-                    else {
-                        cout << "\nYou are not registered for this event.\n";
-                    }
-                    break;
+                if (!event.marketing.empty()) {
+                    cout << "\n*** Advertisement ***\n";
+                    cout << event.marketing << endl;
+                    cout << "*********************\n";
                 }
-            } 
 
-            if (!found) {
+                bool isRegistered = event.attendees.contains(attendee.id);
+                if (isRegistered) {
+                    cout << "\nYou are registered for this event.\n";
+                }
+                else {
+                    cout << "\nYou are not registered for this event.\n";
+                }
+            }
+            else {
                 cout << "Event not found.\n";
             }
             pauseScreen();
@@ -198,13 +210,14 @@ void attendeeMenu(User& attendee) {
             cout << string(90, '-') << endl;
 
             bool hasAvailableEvents = false;
-            for (const Event& event : events) {
-                bool isRegistered = find(event.attendees.begin(), event.attendees.end(), attendee.id) != event.attendees.end();
-                if (!isRegistered && event.status == EventStatus::UPCOMING) {
+            for (const Event* upcoming : events.byStatus(EventStatus::UPCOMING)) {
+                const Event& event = *upcoming;
+                bool isRegistered = event.attendees.contains(attendee.id);
+                if (!isRegistered) {
                     hasAvailableEvents = true;
                     cout << setw(5) << event.id << setw(25) << (event.title.length() > 20 ? event.title.substr(0, 20) + "..." : event.title)
-                        << setw(12) << event.date << setw(10) << event.time
-                        << setw(20) << (event.location.length() > 15 ? event.location.substr(0, 15) + "..." : event.location)
+                        << setw(12) << event.dateText() << setw(10) << event.timeText()
+                        << setw(20) << (event.location.str().length() > 15 ? event.location.str().substr(0, 15) + "..." : event.location)
                         << setw(12) << statusToString(event.status) << endl;
                 }
             }
@@ -224,44 +237,41 @@ void attendeeMenu(User& attendee) {
                 break;
             }
 
-            bool found = false;
-            for (Event& event : events) {
-                if (event.id == eventId) {
-                    found = true;
-
-                    if (event.status != EventStatus::UPCOMING) {
-                        cout << "Cannot register for events that are not UPCOMING.\n";
-                        break;
-                    }
+            const Event* match = events.find(eventId);
+            if (!match) {
+                cout << "Event not found.\n";
+            }
+            else if (match->status != EventStatus::UPCOMING) {
+                cout << "Cannot register for events that are not UPCOMING.\n";
+            }
+            else {
+                const Event& event = *match;
+                bool isRegistered = event.attendees.contains(attendee.id);
+                if (isRegistered) {
+                    cout << "You are already registered for '" << event.title << "'.\n";
+                }
+                else {
+                    // Show confirmation
+                    cout << "\nEvent: " << event.title << endl;
+                    cout << "Date: " << event.dateText() << " at " << event.timeText() << endl;
+                    cout << "Location: " << event.location << endl;
+                    cout << "\nConfirm registration? (y/n): ";
 
-                    bool isRegistered = find(event.attendees.begin(), event.attendees.end(), attendee.id) != event.attendees.end();
-                    if (isRegistered) {
-                        cout << "You are already registered for '" << event.title << "'.\n";
-                    }
-                    else {
-                        // Show confirmation
-                        cout << "\nEvent: " << event.title << endl;
-                        cout << "Date: " << event.date << " at " << event.time << endl;
-                        cout << "Location: " << event.location << endl;
-                        cout << "\nConfirm registration? (y/n): ";
-
-                        char confirm = getYesNoInput();
-                        if (tolower(confirm) == 'y') {
-                            event.attendees.push_back(attendee.id);
-                            saveEventsToFile(events);
+                    char confirm = getYesNoInput();
+                    if (tolower(confirm) == 'y') {
+                        ServiceResult result = EventService(events).registerAttendee(event.id, attendee.id);
+                        if (result.ok()) {
                             cout << "Successfully registered for '" << event.title << "'!\n";
                         }
                         else {
-                            cout << "Registration cancelled.\n";
+                            cout << "Registration failed: " << result.message << ".\n";
                         }
                     }
-                    break;
+                    else {
+                        cout << "Registration cancelled.\n";
+                    }
                 }
             }
-
-            if (!found) {
-                cout << "Event not found.\n";
-            }
             pauseScreen();
             break;
         }
@@ -269,15 +279,8 @@ void attendeeMenu(User& attendee) {
             clearScreen();
             cout << "===== CANCEL REGISTRATION =====\n\n";
 
-            bool hasRegistrations = false;
-            for (const Event& event : events) {
-                if (find(event.attendees.begin(), event.attendees.end(), attendee.id) != event.attendees.end()) {
-                    hasRegistrations = true;
-                    break;
-                }
-            }
-
-            if (!hasRegistrations) {
+            vector<const Event*> registered = events.byAttendee(attendee.id);
+            if (registered.empty()) {
                 cout << "You haven't registered for any events yet.\n";
                 cout << "\nPress Enter to continue...";
                 cin.ignore();
@@ -291,13 +294,12 @@ void attendeeMenu(User& attendee) {
                 << setw(10) << "Time" << setw(20) << "Location" << setw(12) << "Status" << endl;
             cout << string(90, '-') << endl;
 
-            for (const Event& event : events) {
-                if (find(event.attendees.begin(), event.attendees.end(), attendee.id) != event.attendees.end()) {
-                    cout << setw(5) << event.id << setw(25) << (event.title.length() > 20 ? event.title.substr(0, 20) + "..." : event.title)
-                        << setw(12) << event.date << setw(10) << event.time
-                        << setw(20) << (event.location.length() > 15 ? event.location.substr(0, 15) + "..." : event.location)
-                        << setw(12) << statusToString(event.status) << endl;
-                }
+            for (const Event* mine : registered) {
+                const Event& event = *mine;
+                cout << setw(5) << event.id << setw(25) << (event.title.length() > 20 ? event.title.substr(0, 20) + "..." : event.title)
+                    << setw(12) << event.dateText() << setw(10) << event.timeText()
+                    << setw(20) << (event.location.str().length() > 15 ? event.location.str().substr(0, 15) + "..." : event.location)
+                    << setw(12) << statusToString(event.status) << endl;
             }
 
             cout << "\nEnter ID of event to cancel registration (or 0 to cancel): ";
@@ -310,24 +312,17 @@ void attendeeMenu(User& attendee) {
             }
 
             
-                bool found = false;
-                for (Event& event : events) {
-                    if (event.id == eventId) {
-                        found = true;
-                        auto it = find(event.attendees.begin(), event.attendees.end(), attendee.id);
-                        if (it != event.attendees.end()) {
-                            event.attendees.erase(it);
-                            saveEventsToFile(events);
-                            cout << "Registration canceled for '" << event.title << "'.\n";
-                        }
-                        else {
-                            cout << "You are not registered for this event.\n";
-                        }
-                        break;
+                const Event* match = events.find(eventId);
+                if (match) {
+                    const Event& event = *match;
+                    if (EventService(events).cancelRegistration(event.id, attendee.id).ok()) {
+                        cout << "Registration canceled for '" << event.title << "'.\n";
+                    }
+                    else {
+                        cout << "You are not registered for this event.\n";
                     }
                 }
-
-                if (!found) {
+                else {
                     cout << "Event not found.\n";
                 }
                 cout << "\nPress Enter to continue...";
@@ -341,15 +336,8 @@ void attendeeMenu(User& attendee) {
             clearScreen();
             cout << "===== MY REGISTERED EVENTS =====\n\n";
 
-            bool hasRegistrations = false;
-            for (const Event& event : events) {
-                if (find(event.attendees.begin(), event.attendees.end(), attendee.id) != event.attendees.end()) {
-                    hasRegistrations = true;
-                    break;
-                }
-            }
-
-            if (!hasRegistrations) {
+            vector<const Event*> registered = events.byAttendee(attendee.id);
+            if (registered.empty()) {
                 cout << "You haven't registered for any events yet.\n";
                 cout << "\nPress Enter to continue...";
                 cin.ignore();
@@ -363,22 +351,16 @@ void attendeeMenu(User& attendee) {
                 << setw(15) << "Organizer" << endl;
             cout << string(110, '-') << endl;
 
-            for (const Event& event : events) {
-                if (find(event.attendees.begin(), event.attendees.end(), attendee.id) != event.attendees.end()) {
-                    string organizerName = "Unknown";
-                    for (const User& user : users) {
-                        if (user.id == event.organizerId) {
-                            organizerName = user.name;
-                            break;
-                        }
-                    }
+            for (const Event* mine : registered) {
+                const Event& event = *mine;
+                const User* owner = findUserById(event.organizerId);
+                string organizerName = owner ? owner->name : "Unknown";
 
-                    cout << setw(5) << event.id << setw(25) << (event.title.length() > 20 ? event.title.substr(0, 20) + "..." : event.title)
-                        << setw(12) << event.date << setw(10) << event.time
-                        << setw(20) << (event.location.length() > 15 ? event.location.substr(0, 15) + "..." : event.location)
-                        << setw(12) << statusToString(event.status)
-                        << setw(15) << (organizerName.length() > 12 ? organizerName.substr(0, 12) + "..." : organizerName) << endl;
-                }
+                cout << setw(5) << event.id << setw(25) << (event.title.length() > 20 ? event.title.substr(0, 20) + "..." : event.title)
+                    << setw(12) << event.dateText() << setw(10) << event.timeText()
+                    << setw(20) << (event.location.str().length() > 15 ? event.location.str().substr(0, 15) + "..." : event.location)
+                    << setw(12) << statusToString(event.status)
+                    << setw(15) << (organizerName.length() > 12 ? organizerName.substr(0, 12) + "..." : organizerName) << endl;
             }
 
             cout << "\nEnter an event ID to view details (or 0 to go back): ";
@@ -387,40 +369,31 @@ void attendeeMenu(User& attendee) {
             if (eventId == 0) break;
 
             
-                bool found = false;
-                for (const Event& event : events) {
-                    if (event.id == eventId && find(event.attendees.begin(), event.attendees.end(), attendee.id) != event.attendees.end()) {
-                        found = true;
-                        clearScreen();
-                        cout << "===== EVENT DETAILS =====\n\n";
-                        cout << "Title: " << event.title << endl;
-                        cout << "Description: " << event.description << endl;
-                        cout << "Date: " << event.date << endl;
-                        cout << "Time: " << event.time << endl;
-                        cout << "Location: " << event.location << endl;
-                        cout << "Status: " << statusToString(event.status) << endl;
-
-                        string organizerName = "Unknown";
-                        for (const User& user : users) {
-                            if (user.id == event.organizerId) {
-                                organizerName = user.name;
-                                break;
-                            }
-                        }
-                        cout << "Organizer: " << organizerName << endl;
+                const Event* match = events.find(eventId);
+                if (match && match->attendees.contains(attendee.id)) {
+                    const Event& event = *match;
+                    clearScreen();
+                    cout << "===== EVENT DETAILS =====\n\n";
+                    cout << "Title: " << event.title << endl;
+                    cout << "Description: " << event.description << endl;
+                    cout << "Date: " << event.dateText() << endl;
+                    cout << "Time: " << event.timeText() << endl;
+                    cout << "Location: " << event.location << endl;
+                    cout << "Status: " << statusToString(event.status) << endl;
 
-                        //show advertisement also in "My Registered Events"
-                        if (!event.marketing.empty()) {
-                            cout << "\n*** Advertisement ***\n";
-                            cout << event.marketing << endl;
-                            cout << "*********************\n";
-                        }
+                    const User* owner = findUserById(event.organizerId);
+                    string organizerName = owner ? owner->name : "Unknown";
+                    cout << "Organizer: " << organizerName << endl;
 
-                        break;
+                    //show advertisement also in "My Registered Events"
+                    if (!event.marketing.empty()) {
+                        cout << "\n*** Advertisement ***\n";
+                        cout << event.marketing << endl;
+                        cout << "*********************\n";
                     }
-                }
 
-                if (!found) {
+                }
+                else {
                     cout << "Event not found or you're not registered for it.\n";
                 }
                 cout << "\nPress Enter to continue...";
@@ -435,11 +408,10 @@ void attendeeMenu(User& attendee) {
             cout << "===== RATE AND COMPLAINT =====\n\n";
 
 
-            vector<Event*> completedEvents;
-            for (Event& event : events) {
-                if (event.status == EventStatus::COMPLETED &&
-                    find(event.attendees.begin(), event.attendees.end(), attendee.id) != event.attendees.end()) {
-                    completedEvents.push_back(&event);
+            vector<const Event*> completedEvents;
+            for (const Event* event : events.byAttendee(attendee.id)) {
+                if (event->status == EventStatus::COMPLETED) {
+                    completedEvents.push_back(event);
                 }
             }
 
@@ -464,7 +436,7 @@ void attendeeMenu(User& attendee) {
                 }
                 cout << setw(5) << event->id
                     << setw(25) << (event->title.length() > 20 ? event->title.substr(0, 20) + "..." : event->title)
-                    << setw(12) << event->date
+                    << setw(12) << event->dateText()
                     << setw(10);
                 if (hasRated) cout << fixed << setprecision(1) << userRating;
                 else cout << "Not rated";
@@ -476,8 +448,8 @@ void attendeeMenu(User& attendee) {
 
             if (eventId == 0) break;
 
-            Event* targetEvent = nullptr;
-            for (Event* event : completedEvents) {
+            const Event* targetEvent = nullptr;
+            for (const Event* event : completedEvents) {
                 if (event->id == eventId) {
                     targetEvent = event;
                     break;
@@ -493,7 +465,7 @@ void attendeeMenu(User& attendee) {
 
             Rating userRatingEntry;
             bool hasRated = false;
-            for (Rating& rating : targetEvent->ratings) {
+            for (const Rating& rating : targetEvent->ratings) {
                 if (rating.attendeeId == attendee.id) {
                     userRatingEntry = rating;
                     hasRated = true;
@@ -529,24 +501,13 @@ void attendeeMenu(User& attendee) {
 
             userRatingEntry.attendeeId = attendee.id;
 
-            bool updated = false;
-            for (Rating& rating : targetEvent->ratings) {
-                if (rating.attendeeId == attendee.id) {
-                    rating = userRatingEntry;
-                    updated = true;
-                    break;
-                }
+            ServiceResult result = EventService(events).rateEvent(targetEvent->id, userRatingEntry);
+            if (result.ok()) {
+                cout << "Thank you for your feedback!\n";
             }
-            if (!updated) {
-                targetEvent->ratings.push_back(userRatingEntry);
+            else {
+                cout << "Rating not saved: " << result.message << ".\n";
             }
-
-            double total = 0;
-            for (const Rating& r : targetEvent->ratings) total += r.rating;
-            targetEvent->averageRating = total / targetEvent->ratings.size();
-
-            saveEventsToFile(events);
-            cout << "Thank you for your feedback!\n";
             pauseScreen();
             break;
         }
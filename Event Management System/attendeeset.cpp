@@ -0,0 +1,45 @@
+#include "attendeeset.h"
+#include <algorithm>
+
+using namespace std;
+
+bool AttendeeSet::contains(int userId) const {
+    if (sorted_.empty()) return std::find(order_.begin(), order_.end(), userId) != order_.end();
+    return binary_search(sorted_.begin(), sorted_.end(), userId);
+}
+
+bool AttendeeSet::insert(int userId) {
+    if (sorted_.empty()) {
+        if (std::find(order_.begin(), order_.end(), userId) != order_.end()) return false;
+        order_.push_back(userId);
+        if (order_.size() >= SORTED_INDEX_MIN) {
+            sorted_ = order_;
+            sort(sorted_.begin(), sorted_.end());
+        }
+        return true;
+    }
+    auto pos = lower_bound(sorted_.begin(), sorted_.end(), userId);
+    if (pos != sorted_.end() && *pos == userId) return false;
+    sorted_.insert(pos, userId);
+    order_.push_back(userId);
+    return true;
+}
+
+bool AttendeeSet::erase(int userId) {
+    if (!sorted_.empty()) {
+        auto pos = lower_bound(sorted_.begin(), sorted_.end(), userId);
+        if (pos == sorted_.end() || *pos != userId) return false;
+        sorted_.erase(pos);
+    }
+    auto it = std::find(order_.begin(), order_.end(), userId);
+    if (it == order_.end()) return false;
+    order_.erase(it);
+    // Shrinking back below the threshold returns to plain scanning
+    if (order_.size() < SORTED_INDEX_MIN) sorted_.clear();
+    return true;
+}
+
+void AttendeeSet::clear() {
+    order_.clear();
+    sorted_.clear();
+}
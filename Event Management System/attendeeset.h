@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+using namespace std;
+
+// The user ids registered for one event.
+//
+// Iteration and persistence follow registration order, exactly as the old
+// vector<int> did. Membership is what the menus ask about most ("am I
+// registered?" for every listed event), so small sets are scanned directly
+// and sets of SORTED_INDEX_MIN or more also keep a sorted copy of the ids
+// for binary search. Events are capped at 100 participants, which keeps
+// both arrays a few cache lines long; a hash set would cost more to build
+// and walk than it saves.
+class AttendeeSet {
+public:
+    using const_iterator = vector<int>::const_iterator;
+
+    static const size_t SORTED_INDEX_MIN = 16;
+
+    bool contains(int userId) const;
+    // False when the user was already in the set
+    bool insert(int userId);
+    bool erase(int userId);
+    // Replaces the contents, dropping repeated ids
+    template <typename It>
+    void assign(It first, It last) {
+        clear();
+        for (; first != last; ++first) insert(*first);
+    }
+    void clear();
+    void reserve(size_t n) { order_.reserve(n); }
+
+    size_t size() const { return order_.size(); }
+    bool empty() const { return order_.empty(); }
+    int operator[](size_t i) const { return order_[i]; }
+    const_iterator begin() const { return order_.begin(); }
+    const_iterator end() const { return order_.end(); }
+
+private:
+    vector<int> order_;     // registration order
+    vector<int> sorted_;    // empty below SORTED_INDEX_MIN
+};
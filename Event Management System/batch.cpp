@@ -0,0 +1,169 @@
+#include "batch.h"
+#include <charconv>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+#include <vector>
+#include "event.h"
+#include "eventrepository.h"
+#include "eventservice.h"
+#include "helpers.h"
+#include "mappedfile.h"
+#include "user.h"
+
+using namespace std;
+
+extern EventRepository events;
+
+static bool toInt(string_view field, int& out) {
+    from_chars_result r = from_chars(field.data(), field.data() + field.size(), out);
+    return r.ec == errc() && r.ptr == field.data() + field.size();
+}
+
+static bool toDouble(string_view field, double& out) {
+    from_chars_result r = from_chars(field.data(), field.data() + field.size(), out);
+    return r.ec == errc() && r.ptr == field.data() + field.size();
+}
+
+static string errorText(const ServiceResult& result) {
+    return result.ok() ? string() : string(result.message);
+}
+
+// Each command returns an empty string on success or the reason it failed
+typedef vector<string_view> Fields;
+
+static string addUserCommand(const Fields& f) {
+    if (f.size() != 6) return "expected add-user|username|password|role|name|email";
+    if (f[3] != "organizer" && f[3] != "attendee") return "role must be organizer or attendee";
+
+    User user;
+    user.username.assign(f[1]);
+    user.password.assign(f[2]);
+    user.role = f[3];
+    user.name.assign(f[4]);
+    user.email.assign(f[5]);
+    return errorText(EventService(events).registerUser(user));
+}
+
+static string createEventCommand(const Fields& f, string& reply) {
+    if (f.size() != 8) return "expected create-event|organizer|title|description|date|slot|hall|participants";
+    const User* organizer = findUserByUsername(string(f[1]));
+    if (!organizer) return "organizer not found";
+
+    Event ev;
+    ev.organizerId = organizer->id;
+    ev.title.assign(f[2]);
+    ev.description.assign(f[3]);
+    ev.date = CalendarDay::parse(f[4]);
+
+    int slot, hall;
+    if (!toInt(f[5], slot) || slot < 1 || slot > TIME_SLOT_COUNT) return "slot must be 1-4";
+    if (!toInt(f[6], hall) || hall < 1 || hall > HALL_COUNT) return "hall must be 1-3";
+    ev.time = static_cast<TimeSlot>(slot - 1);
+    ev.location = HALLS[hall - 1].name;
+    if (!toInt(f[7], ev.expectedParticipants)) return "participants must be 1-100";
+    ev.themeName = "None";
+    ev.vendorName = "None";
+
+    ServiceResult result = EventService(events).createEvent(ev);
+    if (result.ok()) reply = "created event " + to_string(ev.id);
+    return errorText(result);
+}
+
+static string registrationCommand(const Fields& f, bool add) {
+    if (f.size() != 3) return add ? "expected register|event id|username" : "expected cancel|event id|username";
+    int eventId;
+    if (!toInt(f[1], eventId)) return "invalid event id";
+    const User* attendee = findUserByUsername(string(f[2]));
+    if (!attendee || attendee->role != ROLE_ATTENDEE) return "attendee not found";
+
+    EventService service(events);
+    return errorText(add ? service.registerAttendee(eventId, attendee->id) : service.cancelRegistration(eventId, attendee->id));
+}
+
+static string statusCommand(const Fields& f) {
+    if (f.size() != 3) return "expected status|event id|status";
+    int eventId;
+    if (!toInt(f[1], eventId)) return "invalid event id";
+    if (f[2] != "UPCOMING" && f[2] != "ONGOING" && f[2] != "COMPLETED" && f[2] != "CANCELLED") {
+        return "status must be UPCOMING, ONGOING, COMPLETED or CANCELLED";
+    }
+    return errorText(EventService(events).setStatus(eventId, stringToStatus(f[2])));
+}
+
+static string rateCommand(const Fields& f) {
+    if (f.size() < 4 || f.size() > 6) return "expected rate|event id|username|rating|comment|complaint";
+    int eventId;
+    if (!toInt(f[1], eventId)) return "invalid event id";
+    const User* attendee = findUserByUsername(string(f[2]));
+    if (!attendee) return "attendee did not attend this event";
+
+    Rating rating;
+    rating.attendeeId = attendee->id;
+    if (!toDouble(f[3], rating.rating)) return "rating must be 1.0-5.0";
+    if (f.size() > 4) rating.comment.assign(f[4]);
+    if (f.size() > 5) rating.complaint.assign(f[5]);
+    return errorText(EventService(events).rateEvent(eventId, rating));
+}
+
+static string deleteEventCommand(const Fields& f) {
+    if (f.size() != 2) return "expected delete-event|event id";
+    int eventId;
+    if (!toInt(f[1], eventId)) return "invalid event id";
+    return errorText(EventService(events).deleteEvent(eventId));
+}
+
+static string runCommand(const Fields& f, string& reply) {
+    string_view name = f[0];
+    if (name == "add-user") return addUserCommand(f);
+    if (name == "create-event") return createEventCommand(f, reply);
+    if (name == "register") return registrationCommand(f, true);
+    if (name == "cancel") return registrationCommand(f, false);
+    if (name == "status") return statusCommand(f);
+    if (name == "rate") return rateCommand(f);
+    if (name == "delete-event") return deleteEventCommand(f);
+    return "unknown command '" + string(name) + "'";
+}
+
+string runBatchCommand(string_view line, string& reply) {
+    Fields fields;
+    splitFields(line, "|", fields);
+    reply.clear();
+    if (fields.empty()) return "empty command";
+    return runCommand(fields, reply);
+}
+
+int runBatch(istream& in) {
+    string line, reply;
+    int lineNumber = 0, succeeded = 0, failed = 0;
+
+    while (getline(in, line)) {
+        lineNumber++;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+
+        string error = runBatchCommand(line, reply);
+        if (error.empty()) {
+            succeeded++;
+            if (!reply.empty()) cout << reply << "\n";
+        }
+        else {
+            failed++;
+            cerr << "line " << lineNumber << ": " << error << endl;
+        }
+    }
+
+    cout << "Batch finished: " << succeeded << " succeeded, " << failed << " failed." << endl;
+    return failed;
+}
+
+int runBatchFile(const string& filename) {
+    if (filename.empty() || filename == "-") return runBatch(cin);
+
+    ifstream in(filename);
+    if (!in) {
+        cerr << "Error: Cannot open " << filename << endl;
+        return 1;
+    }
+    return runBatch(in);
+}
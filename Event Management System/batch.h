@@ -0,0 +1,31 @@
+#pragma once
+#include <istream>
+#include <string>
+#include <string_view>
+
+using namespace std;
+
+// Headless command mode: assignment2 --batch [file]   (stdin when no file or "-")
+//
+// One command per line, fields separated by '|'. Blank lines and lines
+// starting with '#' are skipped.
+//
+//   add-user|username|password|organizer or attendee|name|email
+//   create-event|organizer username|title|description|YYYY-MM-DD|slot 1-4|hall 1-3|participants
+//   register|event id|attendee username
+//   cancel|event id|attendee username
+//   status|event id|UPCOMING, ONGOING, COMPLETED or CANCELLED
+//   rate|event id|attendee username|1.0-5.0[|comment[|complaint]]
+//   delete-event|event id
+//
+// Commands go through the same EventService as the menus, so they are
+// checked against the same rules, except that no payment is taken.
+// Failures are reported as "line N: ..." on stderr and do not stop the run.
+
+// Runs one command line. Returns "" on success or the reason it failed;
+// `reply` gets any output (e.g. "created event 12").
+string runBatchCommand(string_view line, string& reply);
+
+// Returns the number of failed commands.
+int runBatch(istream& in);
+int runBatchFile(const string& filename);
@@ -0,0 +1,455 @@
+#include "benchmark.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <thread>
+#include "event.h"
+#include "eventrepository.h"
+#include "eventstore.h"
+#include "scheduleindex.h"
+#include "user.h"
+#include "workload.h"
+
+using namespace std;
+
+extern vector<User> users;
+
+// The getline/stringstream loader that loadEventsFromFile replaced, kept as the baseline
+static void loadEventsLegacy(vector<Event>& events, const string& filename) {
+    events.clear();
+    ifstream inFile(filename);
+
+    if (!inFile) {
+        return;
+    }
+
+    string line;
+    int lineNumber = 0;
+
+    while (getline(inFile, line)) {
+        lineNumber++;
+        if (line.empty() || line[0] == '#') continue;
+
+        stringstream ss(line);
+        string token;
+        vector<string> tokens;
+
+        while (getline(ss, token, '|')) {
+            tokens.push_back(token);
+        }
+
+        if (tokens.size() < 16) {
+            cerr << "Warning: Invalid format on line " << lineNumber << endl;
+            continue;
+        }
+
+        try {
+            Event ev;
+            ev.id = stoi(tokens[0]);
+            ev.title = tokens[1];
+            ev.description = tokens[2];
+            ev.setDateText(tokens[3]);
+            ev.setTimeText(tokens[4]);
+            ev.location = tokens[5];
+            ev.organizerId = stoi(tokens[6]);
+
+            // Parse attendees
+            if (!tokens[7].empty()) {
+                stringstream attStream(tokens[7]);
+                string attId;
+                while (getline(attStream, attId, ',')) {
+                    if (!attId.empty()) ev.attendees.insert(stoi(attId));
+                }
+            }
+
+            ev.expectedParticipants = stoi(tokens[8]);
+            ev.totalFee = stod(tokens[9]);
+            ev.themeCost = stod(tokens[10]);
+            ev.themeName = tokens[11];
+            ev.vendorName = tokens[12];
+            ev.marketing = tokens[13];
+            ev.status = stringToStatus(tokens[14]);
+            ev.averageRating = stod(tokens[15]);
+
+            // Parse ratings
+            if (tokens.size() > 16 && !tokens[16].empty()) {
+                stringstream ratingStream(tokens[16]);
+                string ratingEntry;
+                while (getline(ratingStream, ratingEntry, ';')) {
+                    stringstream entryStream(ratingEntry);
+                    string part;
+                    Rating rating;
+
+                    getline(entryStream, part, ',');
+                    rating.attendeeId = stoi(part);
+
+                    getline(entryStream, part, ',');
+                    rating.rating = stod(part);
+
+                    getline(entryStream, rating.comment, ',');
+                    getline(entryStream, rating.complaint, ',');
+
+                    ev.ratings.push_back(rating);
+                }
+            }
+
+            events.push_back(ev);
+        }
+        catch (const exception& e) {
+            cerr << "Warning: Error parsing line " << lineNumber << ": " << e.what() << endl;
+        }
+    }
+}
+
+static void writeSyntheticEvents(const string& filename, int count) {
+    ofstream out(filename, ios::trunc);
+    for (int i = 1; i <= count; i++) {
+        out << i << "|Event " << i << "|Synthetic benchmark event number " << i << "|2026-0"
+            << (i % 9 + 1) << "-1" << (i % 10) << '|' << Event::slotOptions[i % 4]
+            << "|1st Floor Banquet Hall|" << 1000 + i % 50 << '|';
+        for (int a = 0; a < i % 8; a++) out << (a ? "," : "") << 2000 + (i * 7 + a) % 500;
+        out << '|' << i % 100 + 1 << '|' << 50 + i % 500 << ".5|" << (i % 3) * 100
+            << "|None|None|Come along!|COMPLETED|" << (i % 5) + 0.5 << '|';
+        for (int r = 0; r < i % 4; r++) {
+            out << (r ? ";" : "") << 2000 + r << ',' << r + 1 << ".5,Nice event,";
+        }
+        out << '\n';
+    }
+}
+
+template <typename Loader>
+static double timeLoader(Loader load, const string& filename, int rounds, vector<Event>& result) {
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++) {
+        load(result, filename);
+    }
+    chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+    return elapsed.count() / rounds;
+}
+
+int runParserBenchmark(const string& filename, int rounds) {
+    ifstream probe(filename);
+    if (!probe) {
+        cout << filename << " not found, writing 100000 synthetic events to it." << endl;
+        writeSyntheticEvents(filename, 100000);
+    }
+    probe.close();
+
+    vector<Event> legacy, single, parallel;
+    double legacyMs = timeLoader(loadEventsLegacy, filename, rounds, legacy);
+    double singleMs = timeLoader([](vector<Event>& events, const string& file) { loadEventsFromFile(events, file, 1); },
+        filename, rounds, single);
+    double parallelMs = timeLoader([](vector<Event>& events, const string& file) {
+        loadEventsFromFile(events, file, max(2u, thread::hardware_concurrency()));
+    }, filename, rounds, parallel);
+
+    cout << "Parsed " << single.size() << " events from " << filename << " (" << rounds << " rounds)\n";
+    cout << "  getline/stringstream:  " << legacyMs << " ms per load\n";
+    cout << "  record tokenizer:      " << singleMs << " ms per load\n";
+    cout << "  tokenizer, " << max(2u, thread::hardware_concurrency()) << " threads: " << parallelMs << " ms per load\n";
+    if (singleMs > 0 && parallelMs > 0) {
+        cout << "  speedup vs baseline:   " << legacyMs / singleMs << "x single, " << legacyMs / parallelMs << "x parallel\n";
+    }
+
+    if (legacy.size() != single.size() || single.size() != parallel.size()) {
+        cerr << "Error: loaders disagree (" << legacy.size() << ", " << single.size() << ", "
+            << parallel.size() << " events)" << endl;
+        return 1;
+    }
+    for (size_t i = 0; i < single.size(); i++) {
+        if (single[i].id != parallel[i].id) {
+            cerr << "Error: parallel load changed the event order at index " << i << endl;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Swallows cout while a loader prints its progress notes
+class NullBuffer : public streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+class QuietCout {
+public:
+    QuietCout() { old_ = cout.rdbuf(&null_); }
+    ~QuietCout() { cout.rdbuf(old_); }
+
+private:
+    NullBuffer null_;
+    streambuf* old_;
+};
+
+// Keeps the compiler from dropping loops whose results are otherwise unused
+static volatile size_t benchmarkSink;
+
+const size_t BENCH_LOOKUPS = 100000;
+
+template <typename Body>
+static double timeRounds(int rounds, Body body) {
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++) {
+        body();
+    }
+    chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+    return elapsed.count() / rounds;
+}
+
+static void printRow(const char* name, int eventCount, size_t userCount, int rounds, double ms, size_t ops) {
+    cout << name << ',' << eventCount << ',' << userCount << ',' << rounds << ','
+        << fixed << setprecision(3) << ms << ',' << ops << ','
+        << (ops > 0 ? ms * 1e6 / ops : 0.0) << '\n';
+}
+
+int runBenchmarkSuite(int eventCount, int rounds, const string& prefix) {
+    string usersFile = prefix + "users.dat";
+    string eventsFile = prefix + "events.dat";
+    string binaryFile = prefix + "events.bin";
+
+    WorkloadOptions options;
+    options.events = eventCount;
+    vector<User> synthUsers;
+    vector<Event> synthEvents;
+    generateWorkload(options, synthUsers, synthEvents);
+    size_t userCount = synthUsers.size();
+
+    cout << "benchmark,events,users,rounds,ms_per_round,ops_per_round,ns_per_op\n";
+    auto report = [&](const char* name, double ms, size_t ops) {
+        printRow(name, eventCount, userCount, rounds, ms, ops);
+    };
+
+    report("save_users", timeRounds(rounds, [&] { saveUsersToFile(synthUsers, usersFile); }), userCount);
+    report("save_events_text", timeRounds(rounds, [&] { saveEventsToFile(synthEvents, eventsFile); }), synthEvents.size());
+    report("save_events_binary", timeRounds(rounds, [&] { saveEventsToBinaryFile(synthEvents, binaryFile); }), synthEvents.size());
+
+    vector<User> loadedUsers;
+    vector<Event> loadedEvents;
+    double usersMs, textMs, binaryMs;
+    {
+        QuietCout quiet;
+        usersMs = timeRounds(rounds, [&] { loadUsersFromFile(loadedUsers, usersFile); });
+        textMs = timeRounds(rounds, [&] { loadEventsFromFile(loadedEvents, eventsFile); });
+        binaryMs = timeRounds(rounds, [&] { loadEventsFromBinaryFile(loadedEvents, binaryFile); });
+    }
+    report("load_users", usersMs, userCount);
+    report("load_events_text", textMs, synthEvents.size());
+    report("load_events_binary", binaryMs, synthEvents.size());
+    if (loadedUsers.size() != userCount || loadedEvents.size() != synthEvents.size()) {
+        cerr << "Error: reloaded " << loadedUsers.size() << " users and " << loadedEvents.size()
+            << " events, expected " << userCount << " and " << synthEvents.size() << endl;
+        return 1;
+    }
+
+    // Index build, excluding the copy that feeds it
+    EventRepository repo;
+    double loadMs = 0;
+    for (int r = 0; r < rounds; r++) {
+        vector<Event> copy = synthEvents;
+        loadMs += timeRounds(1, [&] { repo.load(move(copy)); });
+    }
+    report("repository_load", loadMs / rounds, synthEvents.size());
+
+    // Login works on the global user table and its index
+    users = move(loadedUsers);
+    rebuildUserIndex();
+
+    mt19937 rng(54321);
+    uniform_int_distribution<size_t> pickUser(0, userCount * 10 / 9);
+    vector<pair<string, string>> logins;
+    logins.reserve(BENCH_LOOKUPS);
+    for (size_t i = 0; i < BENCH_LOOKUPS; i++) {
+        size_t u = pickUser(rng);     // roughly one in ten names is unknown
+        logins.emplace_back("user" + to_string(u), "pass" + to_string(u));
+    }
+    report("login_lookup", timeRounds(rounds, [&] {
+        size_t ok = 0;
+        for (const auto& login : logins) {
+            const User* user = findUserByUsername(login.first);
+            if (user && user->password == login.second) ok++;
+        }
+        benchmarkSink = ok;
+    }), logins.size());
+
+    vector<const Event*> pool;
+    pool.reserve(repo.size());
+    for (const Event& ev : repo) pool.push_back(&ev);
+    uniform_int_distribution<size_t> pickEvent(0, pool.size() - 1);
+
+    vector<ScheduleKey> probes;
+    probes.reserve(BENCH_LOOKUPS);
+    for (size_t i = 0; i < BENCH_LOOKUPS; i++) {
+        const Event* ev = pool[pickEvent(rng)];
+        // Half the probes hit a booked slot, half look at the next day
+        probes.push_back(ScheduleKey{ i % 2 ? ev->date.plusDays(1) : ev->date, ev->location, ev->time });
+    }
+    report("conflict_check", timeRounds(rounds, [&] {
+        size_t available = 0;
+        for (const ScheduleKey& key : probes) {
+            if (repo.schedule().isFree(key.location, key.date, key.time)) available++;
+        }
+        benchmarkSink = available;
+    }), probes.size());
+
+    int firstAttendee = users[userCount / 10].id;
+    uniform_int_distribution<int> pickAttendee(firstAttendee, users.back().id);
+    vector<pair<int, int>> registrations;
+    registrations.reserve(BENCH_LOOKUPS);
+    for (size_t i = 0; i < BENCH_LOOKUPS; i++) {
+        registrations.emplace_back(pool[pickEvent(rng)]->id, pickAttendee(rng));
+    }
+    report("register_cancel", timeRounds(rounds, [&] {
+        vector<char> added(registrations.size());
+        for (size_t i = 0; i < registrations.size(); i++) {
+            added[i] = repo.addAttendee(registrations[i].first, registrations[i].second);
+        }
+        for (size_t i = registrations.size(); i-- > 0;) {
+            if (added[i]) repo.removeAttendee(registrations[i].first, registrations[i].second);
+        }
+    }), registrations.size() * 2);
+
+    // The attendee browse screen: "registered?" against every event
+    const int browsingAttendees = 10;
+    report("membership_check", timeRounds(rounds, [&] {
+        size_t registered = 0;
+        for (int userId = firstAttendee; userId < firstAttendee + browsingAttendees; userId++) {
+            for (const Event* ev : pool) registered += ev->attendees.contains(userId);
+        }
+        benchmarkSink = registered;
+    }), pool.size() * browsingAttendees);
+    report("my_registrations", timeRounds(rounds, [&] {
+        size_t registered = 0;
+        for (int userId = firstAttendee; userId < firstAttendee + browsingAttendees; userId++) {
+            registered += repo.byAttendee(userId).size();
+        }
+        benchmarkSink = registered;
+    }), browsingAttendees);
+    // Organizer ids start at users[0], the busiest under the workload's skew
+    report("organizer_events", timeRounds(rounds, [&] {
+        size_t organized = 0;
+        for (int i = 0; i < browsingAttendees; i++) organized += repo.byOrganizer(users[i].id).size();
+        benchmarkSink = organized;
+    }), browsingAttendees);
+
+    report("status_filter", timeRounds(rounds, [&] {
+        size_t listed = 0;
+        for (int s = 0; s < EVENT_STATUS_COUNT; s++) listed += repo.byStatus(static_cast<EventStatus>(s)).size();
+        benchmarkSink = listed;
+    }), EVENT_STATUS_COUNT);
+
+    // Month-long windows starting on the dates of random events
+    const int DATE_WINDOWS = 20;
+    vector<CalendarDay> windowStarts;
+    for (int i = 0; i < DATE_WINDOWS; i++) windowStarts.push_back(pool[pickEvent(rng)]->date);
+    report("date_range", timeRounds(rounds, [&] {
+        size_t listed = 0;
+        for (CalendarDay from : windowStarts) listed += repo.between(from, from.plusDays(30)).size();
+        benchmarkSink = listed;
+    }), DATE_WINDOWS);
+
+    // The sold-out check the server makes before queueing a registration
+    vector<int> seatProbes;
+    seatProbes.reserve(BENCH_LOOKUPS);
+    for (size_t i = 0; i < BENCH_LOOKUPS; i++) seatProbes.push_back(pool[pickEvent(rng)]->id);
+    report("seats_left", timeRounds(rounds, [&] {
+        size_t open = 0;
+        for (int id : seatProbes) open += repo.seatsLeft(id) > 0;
+        benchmarkSink = open;
+    }), seatProbes.size());
+
+    // Searches a browsing attendee might type, from one word to a broad prefix
+    const char* const queries[] = { "wedding", "tech conf", "party 2nd floor", "gala", "reun", "organizer 1001" };
+    report("keyword_search", timeRounds(rounds, [&] {
+        size_t found = 0;
+        for (const char* query : queries) found += repo.search(query).size();
+        benchmarkSink = found;
+    }), size(queries));
+
+    vector<pair<int, Rating>> ratings;
+    ratings.reserve(BENCH_LOOKUPS);
+    for (size_t i = 0; i < BENCH_LOOKUPS; i++) {
+        Rating rating;
+        rating.attendeeId = pickAttendee(rng);
+        rating.rating = 1.0 + i % 5;
+        ratings.emplace_back(pool[pickEvent(rng)]->id, rating);
+    }
+    report("rating_update", timeRounds(rounds, [&] {
+        for (const auto& entry : ratings) repo.putRating(entry.first, entry.second);
+    }), ratings.size());
+    report("rating_stats_all", timeRounds(rounds, [&] {
+        benchmarkSink = repo.ratingStatsAll().count;
+    }), repo.size());
+
+    return 0;
+}
+
+const int STRESS_ATTEMPTS_PER_THREAD = 5000;
+
+int runSeatStress(int threads, int capacity) {
+    EventRepository repo;
+    Event popular;
+    popular.id = 1;
+    popular.title = "Popular event";
+    popular.expectedParticipants = capacity;
+    repo.put(popular);
+
+    // Stands in for the server's shard lock around the attendee list
+    mutex attendeeLock;
+    atomic<int> committed(0), cancelled(0), released(0), refused(0), overbooked(0);
+
+    auto start = chrono::steady_clock::now();
+    vector<thread> pool;
+    for (int t = 0; t < threads; t++) {
+        pool.emplace_back([&, t] {
+            mt19937 rng(t + 1);
+            const SeatCounter* seats = repo.seats(1);
+            for (int i = 0; i < STRESS_ATTEMPTS_PER_THREAD; i++) {
+                int userId = t * STRESS_ATTEMPTS_PER_THREAD + i + 1;
+                if (!repo.reserveSeat(1)) {
+                    refused++;
+                    continue;
+                }
+                if (seats->claimed() > capacity) overbooked++;
+
+                // A quarter of the claims back out, as if payment failed
+                if (rng() % 4 == 0) {
+                    repo.releaseSeat(1);
+                    released++;
+                    continue;
+                }
+                lock_guard<mutex> lock(attendeeLock);
+                repo.commitSeat(1, userId);
+                committed++;
+                if (rng() % 8 == 0) {
+                    repo.removeAttendee(1, userId);
+                    cancelled++;
+                }
+            }
+        });
+    }
+    for (thread& worker : pool) worker.join();
+    chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+
+    int attendees = static_cast<int>(repo.find(1)->attendees.size());
+    const SeatCounter* seats = repo.seats(1);
+    cout << threads << " threads x " << STRESS_ATTEMPTS_PER_THREAD << " claims on " << capacity << " seats in "
+        << elapsed.count() << " ms: " << committed << " committed, " << cancelled << " cancelled, "
+        << released << " released, " << refused << " refused\n";
+    cout << "Final: " << attendees << " attendees, " << seats->taken() << " taken, "
+        << seats->reserved() << " reserved\n";
+
+    bool ok = overbooked == 0 && attendees <= capacity && attendees == committed - cancelled
+        && seats->taken() == attendees && seats->reserved() == 0;
+    if (!ok) {
+        cerr << "Error: seat accounting broken (" << overbooked << " overbooked claims)" << endl;
+        return 1;
+    }
+    cout << "No overbooking." << endl;
+    return 0;
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <string>
+
+using namespace std;
+
+// Times loadEventsFromFile (single-threaded and parallel) against the old
+// getline/stringstream loader.
+// Writes synthetic data to `filename` first if it does not exist.
+int runParserBenchmark(const string& filename = "bench_events.dat", int rounds = 5);
+
+// Hot-path suite: assignment2 --bench [events] [rounds] [file prefix]
+//
+// Generates a workload (see workload.h) at the given scale, writes it to
+// <prefix>users.dat / <prefix>events.dat / <prefix>events.bin and times
+// loading, saving, login lookup, conflict checks, registration and rating
+// updates. Results go to stdout as CSV, one row per benchmark:
+//   benchmark,events,users,rounds,ms_per_round,ops_per_round,ns_per_op
+int runBenchmarkSuite(int eventCount = 10000, int rounds = 3, const string& prefix = "bench_suite_");
+
+// Seat stress check: assignment2 --stress-seats [threads] [capacity]
+//
+// Many threads race to register for one event of the given capacity, with
+// some backing out before committing and some cancelling afterwards.
+// Returns non-zero if the event was ever overbooked or the seat count
+// disagrees with the attendee list at the end.
+int runSeatStress(int threads = 16, int capacity = 100);
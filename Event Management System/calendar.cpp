@@ -0,0 +1,72 @@
+#include "calendar.h"
+
+using namespace std;
+
+static bool isLeapYear(int year) {
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+static int daysInMonth(int year, int month) {
+    static const int DAYS[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    return month == 2 && isLeapYear(year) ? 29 : DAYS[month - 1];
+}
+
+// Proleptic Gregorian conversions with the year starting in March, so the
+// leap day is the last day of a "year" and month lengths repeat every 5 months
+CalendarDay CalendarDay::fromCivil(int year, int month, int day) {
+    if (month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)) return CalendarDay();
+
+    int y = month <= 2 ? year - 1 : year;
+    int era = (y >= 0 ? y : y - 399) / 400;
+    int yearOfEra = y - era * 400;
+    int dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return CalendarDay(era * 146097 + dayOfEra - 719468);
+}
+
+void CalendarDay::toCivil(int& year, int& month, int& day) const {
+    int32_t z = days_ + 719468;
+    int era = (z >= 0 ? z : z - 146096) / 146097;
+    int dayOfEra = z - era * 146097;
+    int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int mp = (5 * dayOfYear + 2) / 153;
+    day = dayOfYear - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0);
+}
+
+CalendarDay CalendarDay::parse(string_view text) {
+    if (text.size() != 10 || text[4] != '-' || text[7] != '-') return CalendarDay();
+
+    int fields[3] = {};
+    const size_t starts[3] = { 0, 5, 8 };
+    const size_t lengths[3] = { 4, 2, 2 };
+    for (int f = 0; f < 3; f++) {
+        for (size_t i = starts[f]; i < starts[f] + lengths[f]; i++) {
+            if (text[i] < '0' || text[i] > '9') return CalendarDay();
+            fields[f] = fields[f] * 10 + (text[i] - '0');
+        }
+    }
+    return fromCivil(fields[0], fields[1], fields[2]);
+}
+
+string CalendarDay::toString() const {
+    if (empty()) return "";
+
+    int year, month, day;
+    toCivil(year, month, day);
+    if (year < 0 || year > 9999) return "";
+
+    string out = "0000-00-00";
+    for (int i = 3; i >= 0; i--, year /= 10) out[i] = static_cast<char>('0' + year % 10);
+    out[5] = static_cast<char>('0' + month / 10);
+    out[6] = static_cast<char>('0' + month % 10);
+    out[8] = static_cast<char>('0' + day / 10);
+    out[9] = static_cast<char>('0' + day % 10);
+    return out;
+}
+
+ostream& operator<<(ostream& out, CalendarDay day) {
+    return out << day.toString();
+}
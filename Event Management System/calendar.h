@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+using namespace std;
+
+// A calendar date packed into one integer: the number of days since 1970-01-01.
+//
+// Events hold their date in this form, so sorting, date ranges and booking
+// lookups are integer compares and "the next day" is + 1. Text is parsed and
+// formatted only where a date enters or leaves the program (files, journal,
+// menus, server). A default-constructed day is "no date" and sorts first.
+class CalendarDay {
+public:
+    CalendarDay() = default;
+
+    // No date unless month and day name a real day of that year
+    static CalendarDay fromCivil(int year, int month, int day);
+    static CalendarDay fromDays(int32_t days) { return CalendarDay(days); }
+    // Strict YYYY-MM-DD; no date for anything else
+    static CalendarDay parse(string_view text);
+
+    bool empty() const { return days_ == NO_DAY; }
+    int32_t days() const { return days_; }
+    void toCivil(int& year, int& month, int& day) const;
+    // YYYY-MM-DD, or "" for no date
+    string toString() const;
+
+    // Stays "no date" when empty
+    CalendarDay plusDays(int days) const { return empty() ? *this : CalendarDay(days_ + days); }
+
+    bool operator==(CalendarDay other) const { return days_ == other.days_; }
+    bool operator!=(CalendarDay other) const { return days_ != other.days_; }
+    bool operator<(CalendarDay other) const { return days_ < other.days_; }
+    bool operator<=(CalendarDay other) const { return days_ <= other.days_; }
+    bool operator>(CalendarDay other) const { return days_ > other.days_; }
+    bool operator>=(CalendarDay other) const { return days_ >= other.days_; }
+
+private:
+    static const int32_t NO_DAY = INT32_MIN;
+
+    explicit CalendarDay(int32_t days) : days_(days) {}
+
+    int32_t days_ = NO_DAY;
+};
+
+// Writes toString(), so setw() and friends still apply
+ostream& operator<<(ostream& out, CalendarDay day);
@@ -1,18 +1,15 @@
 #include "event.h"
-#include <sstream>
+#include "mappedfile.h"
+#include "recordparser.h"
+#include <atomic>
 #include <iostream>
+#include <iterator>
+#include <thread>
 #include <climits>
+#include <cstring>
 
 using namespace std;
 
-int generateEventId(const vector<Event>& events) {
-    int maxId = 0;
-    for (const auto& e : events) {
-        if (e.id > maxId) maxId = e.id;
-    }
-    return maxId + 1; 
-}
-
 string statusToString(EventStatus status) {
     switch (status) {
     case EventStatus::UPCOMING: return "UPCOMING";
@@ -23,7 +20,7 @@ string statusToString(EventStatus status) {
     }
 }
 
-EventStatus stringToStatus(const string& str) {
+EventStatus stringToStatus(string_view str) {
     if (str == "UPCOMING") return EventStatus::UPCOMING;
     if (str == "ONGOING") return EventStatus::ONGOING;
     if (str == "COMPLETED") return EventStatus::COMPLETED;
@@ -31,6 +28,57 @@ EventStatus stringToStatus(const string& str) {
     return EventStatus::UPCOMING;
 }
 
+const string& slotToString(TimeSlot slot) {
+    static const string none;
+    size_t index = static_cast<size_t>(slot);
+    return index < Event::slotOptions.size() ? Event::slotOptions[index] : none;
+}
+
+TimeSlot stringToSlot(string_view str) {
+    for (size_t i = 0; i < Event::slotOptions.size(); i++) {
+        if (str == Event::slotOptions[i]) return static_cast<TimeSlot>(i);
+    }
+    return TimeSlot::NONE;
+}
+
+ostream& operator<<(ostream& out, TimeSlot slot) {
+    return out << slotToString(slot);
+}
+
+void Event::setDateText(string_view text) {
+    date = CalendarDay::parse(text);
+    if (date.empty()) legacyDate.assign(text);
+    else legacyDate.clear();
+}
+
+void Event::setTimeText(string_view text) {
+    time = stringToSlot(text);
+    if (time == TimeSlot::NONE) legacyTime.assign(text);
+    else legacyTime.clear();
+}
+
+const string& Event::timeText() const {
+    return time == TimeSlot::NONE ? legacyTime : slotToString(time);
+}
+
+// Free-text fields may contain the record separators; those are written with
+// a backslash in front (newlines as \n) and undone by RecordTokenizer::readText.
+// The file starts with EVENTS_TEXT_HEADER so readers know to undo them.
+static void writeText(ostream& out, const string& text) {
+    if (text.find_first_of(ESCAPED_CHARS) == string::npos) {
+        out << text;
+        return;
+    }
+    for (char c : text) {
+        if (c == '\n') out << "\\n";
+        else if (c == '\r') out << "\\r";
+        else {
+            if (c != '\0' && strchr(ESCAPED_CHARS, c)) out << '\\';
+            out << c;
+        }
+    }
+}
+
 void saveEventsToFile(const vector<Event>& events, const string& filename) {
     ofstream outFile(filename, ios::trunc);
     if (!outFile) {
@@ -38,12 +86,15 @@ void saveEventsToFile(const vector<Event>& events, const string& filename) {
         return;
     }
 
+    outFile << EVENTS_TEXT_HEADER << '\n';
     for (const auto& ev : events) {
-        outFile << ev.id << '|'
-            << ev.title << '|'
-            << ev.description << '|'
-            << ev.date << '|'
-            << ev.time << '|'
+        outFile << ev.id << '|';
+        writeText(outFile, ev.title);
+        outFile << '|';
+        writeText(outFile, ev.description);
+        outFile << '|'
+            << ev.dateText() << '|'
+            << ev.timeText() << '|'
             << ev.location << '|'
             << ev.organizerId << '|';
 
@@ -56,109 +107,134 @@ void saveEventsToFile(const vector<Event>& events, const string& filename) {
 
         outFile << ev.expectedParticipants << '|'
             << ev.totalFee << '|'
-            << ev.themeCost << '|'
-            << ev.themeName << '|'
-            << ev.vendorName << '|'
-            << ev.marketing << '|'
+            << ev.themeCost << '|';
+        writeText(outFile, ev.themeName);
+        outFile << '|';
+        writeText(outFile, ev.vendorName);
+        outFile << '|';
+        writeText(outFile, ev.marketing);
+        outFile << '|'
             << statusToString(ev.status) << '|'
             << ev.averageRating << '|';
 
         // Save ratings
         for (size_t i = 0; i < ev.ratings.size(); i++) {
             outFile << ev.ratings[i].attendeeId << ','
-                << ev.ratings[i].rating << ','
-                << ev.ratings[i].comment << ','
-                << ev.ratings[i].complaint;
+                << ev.ratings[i].rating << ',';
+            writeText(outFile, ev.ratings[i].comment);
+            outFile << ',';
+            writeText(outFile, ev.ratings[i].complaint);
             if (i < ev.ratings.size() - 1) outFile << ';';
         }
         outFile << '\n';
     }
 }
 
-void loadEventsFromFile(vector<Event>& events, const string& filename) {
+struct LineWarning {
+    int line;       // relative to the start of the chunk
+    RecordError error;
+};
+
+// Parses a run of whole lines. Returns the number of lines consumed.
+static int parseEventLines(string_view text, bool unescape, vector<Event>& events, vector<LineWarning>& warnings) {
+    events.reserve(events.size() + count(text.begin(), text.end(), '\n') + 1);
+
+    string_view line;
+    int lineNumber = 0;
+
+    while (nextLine(text, line)) {
+        lineNumber++;
+        if (line.empty()) continue;
+
+        events.emplace_back();
+        RecordError error;
+        if (!parseEventRecord(line, events.back(), error, unescape)) {
+            events.pop_back();
+            warnings.push_back(LineWarning{ lineNumber, error });
+        }
+    }
+    return lineNumber;
+}
+
+static void printLineWarnings(const vector<LineWarning>& warnings, int firstLine) {
+    for (const LineWarning& w : warnings) {
+        cerr << "Warning: Error parsing line " << firstLine + w.line << ", column " << w.error.column
+            << ": " << w.error.message << endl;
+    }
+}
+
+void loadEventsFromFile(vector<Event>& events, const string& filename, unsigned threads) {
     events.clear();
-    ifstream inFile(filename);
+    MappedFile file;
 
-    if (!inFile) {
+    if (!file.open(filename)) {
         cout << "Note: " << filename << " not found. Starting with empty events list." << endl;
         return;
     }
 
-    string line;
-    int lineNumber = 0;
+    string_view text = file.view();
 
-    while (getline(inFile, line)) {
-        lineNumber++;
-        if (line.empty()) continue;
+    // Only files with the header were written escaped; the header is line 1
+    bool unescape = false;
+    int headerLines = 0;
+    string_view rest = text, first;
+    if (nextLine(rest, first) && first == EVENTS_TEXT_HEADER) {
+        text = rest;
+        unescape = true;
+        headerLines = 1;
+    }
 
-        stringstream ss(line);
-        string token;
-        vector<string> tokens;
+    if (threads == 0) {
+        threads = text.size() < PARALLEL_LOAD_MIN_BYTES ? 1 : max(1u, thread::hardware_concurrency());
+    }
 
-        while (getline(ss, token, '|')) {
-            tokens.push_back(token);
-        }
+    if (threads == 1) {
+        vector<LineWarning> warnings;
+        parseEventLines(text, unescape, events, warnings);
+        printLineWarnings(warnings, headerLines);
+        return;
+    }
 
-        if (tokens.size() < 16) {
-            cerr << "Warning: Invalid format on line " << lineNumber << endl;
-            continue;
-        }
+    // Cut the file into newline-aligned chunks. There are more chunks than
+    // threads so a worker that finishes early can pick up another one.
+    size_t chunkCount = threads * 4;
+    size_t target = text.size() / chunkCount + 1;
+    vector<string_view> chunks;
+    size_t start = 0;
+    while (start < text.size()) {
+        size_t end = start + target < text.size() ? text.find('\n', start + target) : string_view::npos;
+        end = end == string_view::npos ? text.size() : end + 1;
+        chunks.push_back(text.substr(start, end - start));
+        start = end;
+    }
 
-        try {
-            Event ev;
-            ev.id = stoi(tokens[0]);
-            ev.title = tokens[1];
-            ev.description = tokens[2];
-            ev.date = tokens[3];
-            ev.time = tokens[4];
-            ev.location = tokens[5];
-            ev.organizerId = stoi(tokens[6]);
-
-            // Parse attendees
-            if (!tokens[7].empty()) {
-                stringstream attStream(tokens[7]);
-                string attId;
-                while (getline(attStream, attId, ',')) {
-                    if (!attId.empty()) ev.attendees.push_back(stoi(attId));
-                }
-            }
-
-            ev.expectedParticipants = stoi(tokens[8]);
-            ev.totalFee = stod(tokens[9]);
-            ev.themeCost = stod(tokens[10]);
-            ev.themeName = tokens[11];
-            ev.vendorName = tokens[12];
-            ev.marketing = tokens[13];
-            ev.status = stringToStatus(tokens[14]);
-            ev.averageRating = stod(tokens[15]);
-
-            // Parse ratings
-            if (tokens.size() > 16 && !tokens[16].empty()) {
-                stringstream ratingStream(tokens[16]);
-                string ratingEntry;
-                while (getline(ratingStream, ratingEntry, ';')) {
-                    stringstream entryStream(ratingEntry);
-                    string part;
-                    Rating rating;
-
-                    getline(entryStream, part, ',');
-                    rating.attendeeId = stoi(part);
-
-                    getline(entryStream, part, ',');
-                    rating.rating = stod(part);
-
-                    getline(entryStream, rating.comment, ',');
-                    getline(entryStream, rating.complaint, ',');
-
-                    ev.ratings.push_back(rating);
-                }
-            }
-
-            events.push_back(ev);
-        }
-        catch (const exception& e) {
-            cerr << "Warning: Error parsing line " << lineNumber << ": " << e.what() << endl;
+    vector<vector<Event>> parsed(chunks.size());
+    vector<vector<LineWarning>> warnings(chunks.size());
+    vector<int> lineCounts(chunks.size());
+    atomic<size_t> nextChunk(0);
+
+    auto worker = [&]() {
+        for (size_t i = nextChunk++; i < chunks.size(); i = nextChunk++) {
+            lineCounts[i] = parseEventLines(chunks[i], unescape, parsed[i], warnings[i]);
         }
+    };
+    vector<thread> pool;
+    for (unsigned t = 1; t < threads && t < chunks.size(); t++) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (thread& t : pool) t.join();
+
+    // Merge in file order; each chunk's line numbers start where the previous one ended
+    size_t total = 0;
+    for (const vector<Event>& part : parsed) total += part.size();
+    events.reserve(total);
+
+    int firstLine = headerLines;
+    for (size_t i = 0; i < chunks.size(); i++) {
+        printLineWarnings(warnings[i], firstLine);
+        firstLine += lineCounts[i];
+        move(parsed[i].begin(), parsed[i].end(), back_inserter(events));
     }
 }
 
@@ -170,6 +246,75 @@ const vector<string> Event::slotOptions = {
     "18:00-21:00"
 };
 
+int ratingToStars(double rating) {
+    int stars = static_cast<int>(rating);
+    return stars < 1 ? 1 : stars > RATING_STARS ? RATING_STARS : stars;
+}
+
+void RatingStats::add(double rating) {
+    if (count == 0 || rating < min) min = rating;
+    if (count == 0 || rating > max) max = rating;
+    count++;
+    sum += rating;
+    histogram[ratingToStars(rating) - 1]++;
+}
+
+void RatingStats::remove(double rating, const vector<Rating>& remaining) {
+    if (count == 0) return;
+    count--;
+    histogram[ratingToStars(rating) - 1]--;
+    if (count == 0) {
+        sum = min = max = 0.0;
+        return;
+    }
+    sum -= rating;
+
+    if (rating <= min || rating >= max) {
+        min = max = remaining.front().rating;
+        for (const Rating& r : remaining) {
+            if (r.rating < min) min = r.rating;
+            if (r.rating > max) max = r.rating;
+        }
+    }
+}
+
+void RatingStats::merge(const RatingStats& other) {
+    if (other.count == 0) return;
+    if (count == 0 || other.min < min) min = other.min;
+    if (count == 0 || other.max > max) max = other.max;
+    count += other.count;
+    sum += other.sum;
+    for (int i = 0; i < RATING_STARS; i++) histogram[i] += other.histogram[i];
+}
+
+void RatingStats::rebuild(const vector<Rating>& ratings) {
+    *this = RatingStats();
+    for (const Rating& r : ratings) add(r.rating);
+}
+
+bool SeatCounter::reserve(int capacity) {
+    uint64_t state = state_.load();
+    for (;;) {
+        uint64_t claimed = (state >> 32) + (state & 0xFFFFFFFFu);
+        if (capacity <= 0 || claimed >= static_cast<uint64_t>(capacity)) return false;
+        if (state_.compare_exchange_weak(state, state + 1)) return true;
+    }
+}
+
+void SeatCounter::commit() {
+    // One reserved seat becomes a taken one; the total does not change
+    state_ += TAKEN_ONE - 1;
+}
+
+void SeatCounter::release() {
+    state_ -= 1;
+}
+
+int SeatCounter::claimed() const {
+    uint64_t state = state_.load();
+    return static_cast<int>((state >> 32) + (state & 0xFFFFFFFFu));
+}
+
 double calculateTotalFee(int venueCost, int participants, double themeCost) {
     return venueCost + (participants * 5) + themeCost;
 }
@@ -1,8 +1,13 @@
 #pragma once
+#include <atomic>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <fstream>
 #include <algorithm>
+#include "attendeeset.h"
+#include "calendar.h"
 #include "user.h"
 
 using namespace std;
@@ -14,6 +19,19 @@ enum class EventStatus {
     CANCELLED       
 };
 
+const int EVENT_STATUS_COUNT = 4;
+
+// Index into Event::slotOptions
+enum class TimeSlot : uint8_t {
+    MORNING,        // 09:00-12:00
+    MIDDAY,         // 12:00-15:00
+    AFTERNOON,      // 15:00-18:00
+    EVENING,        // 18:00-21:00
+    NONE            // not booked / unreadable
+};
+
+const int TIME_SLOT_COUNT = 4;
+
 
 struct Rating {
     int attendeeId;
@@ -22,37 +40,117 @@ struct Rating {
     string complaint;   
 };
 
+const int RATING_STARS = 5;
+
+// Running aggregates over one event's ratings, kept in step with every
+// insert/edit/delete so nothing has to walk the rating list to summarise it.
+struct RatingStats {
+    uint32_t count = 0;
+    double sum = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+    uint32_t histogram[RATING_STARS] = {};   // [0] = 1 star ... [4] = 5 stars
+
+    double mean() const { return count ? sum / count : 0.0; }
+    uint32_t starCount(int stars) const { return stars >= 1 && stars <= RATING_STARS ? histogram[stars - 1] : 0; }
+
+    void add(double rating);
+    // `remaining` is the rating list after the removal. It is only scanned
+    // when the removed value was the current min or max.
+    void remove(double rating, const vector<Rating>& remaining);
+    void merge(const RatingStats& other);
+    void rebuild(const vector<Rating>& ratings);
+};
+
+// 1-5; a 4.5 counts as a four-star rating
+int ratingToStars(double rating);
+
+// Seats claimed against an event's expectedParticipants.
+//
+// Taken and reserved seats share one 64-bit word (taken in the high half), so
+// a claim is a single compare-and-swap that can never push taken + reserved
+// past capacity, however many threads race for the last seat. A reservation
+// is either committed (the attendee is added) or released (they backed out).
+class SeatCounter {
+public:
+    SeatCounter() = default;
+    SeatCounter(const SeatCounter& other) : state_(other.state_.load()) {}
+    SeatCounter& operator=(const SeatCounter& other) {
+        state_.store(other.state_.load());
+        return *this;
+    }
+
+    // False when every seat is taken or reserved
+    bool reserve(int capacity);
+    void commit();
+    void release();
+    // Seats taken or given back without a reservation (loading, replay, cancellation)
+    void add() { state_ += TAKEN_ONE; }
+    void remove() { state_ -= TAKEN_ONE; }
+    void reset(size_t taken) { state_ = static_cast<uint64_t>(taken) << 32; }
+
+    int taken() const { return static_cast<int>(state_.load() >> 32); }
+    int reserved() const { return static_cast<int>(state_.load() & 0xFFFFFFFFu); }
+    // Taken + reserved, read in one go
+    int claimed() const;
+    int available(int capacity) const { return max(0, capacity - claimed()); }
+
+private:
+    static const uint64_t TAKEN_ONE = uint64_t(1) << 32;
+
+    atomic<uint64_t> state_{ 0 };
+};
+
 
 struct Event {
     int id = 0;
     string title;
     string description;
-    string date;
-    string time;
-    string location;
+    CalendarDay date;
+    TimeSlot time = TimeSlot::NONE;
+    // Stored date/time text that does not parse (older versions accepted
+    // days like 2025-02-30), kept verbatim so a load/save never changes it.
+    // Empty whenever date/time hold the value.
+    string legacyDate;
+    string legacyTime;
+    InternedString location;
     int organizerId = 0;
-    vector<int> attendees;
+    AttendeeSet attendees;
     int expectedParticipants = 0;
     double totalFee = 0.0;
     double themeCost = 0.0;
-    string themeName;
-    string vendorName;
+    InternedString themeName;
+    InternedString vendorName;
     string marketing;
 
     EventStatus status = EventStatus::UPCOMING;
     vector<Rating> ratings;
     double averageRating = 0.0;
+    RatingStats ratingStats;
+
+    // Text as read from and written to files, the journal and the server
+    void setDateText(string_view text);
+    void setTimeText(string_view text);
+    string dateText() const { return date.empty() ? legacyDate : date.toString(); }
+    const string& timeText() const;
 
     static const vector<string> slotOptions;
 };
 
 
 string statusToString(EventStatus status);
-EventStatus stringToStatus(const string& str);
+EventStatus stringToStatus(string_view str);
+// "" for TimeSlot::NONE
+const string& slotToString(TimeSlot slot);
+// TimeSlot::NONE unless `str` is one of Event::slotOptions
+TimeSlot stringToSlot(string_view str);
+ostream& operator<<(ostream& out, TimeSlot slot);
 
 void saveEventsToFile(const vector<Event>& events, const string& filename = "events.dat");
-void loadEventsFromFile(vector<Event>& events, const string& filename = "events.dat");
-int generateEventId(const vector<Event>& events);
+// Files of at least PARALLEL_LOAD_MIN_BYTES are parsed on several threads
+// unless `threads` says otherwise (0 = decide automatically, 1 = single-threaded).
+const size_t PARALLEL_LOAD_MIN_BYTES = 1024 * 1024;
+void loadEventsFromFile(vector<Event>& events, const string& filename = "events.dat", unsigned threads = 0);
 
 double calculateTotalFee(int venueCost, int participants, double themeCost);
 
@@ -0,0 +1,386 @@
+#include "eventrepository.h"
+#include <algorithm>
+
+using namespace std;
+
+// Compact once tombstones outnumber live events (and there are enough to matter)
+static const size_t MIN_TOMBSTONES_TO_COMPACT = 64;
+
+void EventRepository::load(vector<Event>&& loaded) {
+    clear();
+    slots_.reserve(loaded.size());
+    slotById_.reserve(loaded.size());
+    dates_.reserve(loaded.size());
+    capacities_.reserve(loaded.size());
+    seats_.reserve(loaded.size());
+    for (Event& ev : loaded) {
+        put(move(ev));
+    }
+}
+
+void EventRepository::clear() {
+    slots_.clear();
+    slotById_.clear();
+    dates_.clear();
+    capacities_.clear();
+    seats_.clear();
+    schedule_.clear();
+    search_.clear();
+    leaderboard_.clear();
+    registrations_.clear();
+    eventIdsByOrganizer_.clear();
+    statuses_.clear();
+    attendeeTotal_ = 0;
+    revenue_ = 0.0;
+    live_ = 0;
+    maxId_ = 0;
+}
+
+const Event* EventRepository::find(int id) const {
+    auto it = slotById_.find(id);
+    return it == slotById_.end() ? nullptr : slots_[it->second].get();
+}
+
+Event* EventRepository::slotFor(int id) {
+    auto it = slotById_.find(id);
+    return it == slotById_.end() ? nullptr : slots_[it->second].get();
+}
+
+size_t EventRepository::slotOf(int id) const {
+    auto it = slotById_.find(id);
+    return it == slotById_.end() ? slots_.size() : it->second;
+}
+
+vector<const Event*> EventRepository::inCatalogueOrder(const vector<int>& ids) const {
+    // Slot order is catalogue order, so sorting the slots restores it
+    vector<size_t> slots;
+    slots.reserve(ids.size());
+    for (int eventId : ids) {
+        auto it = slotById_.find(eventId);
+        if (it != slotById_.end()) slots.push_back(it->second);
+    }
+    sort(slots.begin(), slots.end());
+
+    vector<const Event*> result;
+    result.reserve(slots.size());
+    for (size_t slot : slots) result.push_back(slots_[slot].get());
+    return result;
+}
+
+void EventRepository::indexOrganizer(const Event& ev) {
+    eventIdsByOrganizer_[ev.organizerId].push_back(ev.id);
+}
+
+void EventRepository::unindexOrganizer(const Event& ev) {
+    auto it = eventIdsByOrganizer_.find(ev.organizerId);
+    if (it == eventIdsByOrganizer_.end()) return;
+    vector<int>& ids = it->second;
+    auto pos = std::find(ids.begin(), ids.end(), ev.id);
+    if (pos == ids.end()) return;
+    *pos = ids.back();
+    ids.pop_back();
+    if (ids.empty()) eventIdsByOrganizer_.erase(it);
+}
+
+void EventRepository::countEvent(const Event& ev, bool added) {
+    if (added) {
+        attendeeTotal_ += ev.attendees.size();
+        revenue_ += ev.totalFee;
+    }
+    else {
+        attendeeTotal_ -= ev.attendees.size();
+        revenue_ -= ev.totalFee;
+    }
+}
+
+vector<const Event*> EventRepository::search(string_view query, size_t limit) const {
+    vector<const Event*> result;
+    for (const SearchHit& hit : search_.search(query, limit)) {
+        if (const Event* ev = find(hit.eventId)) result.push_back(ev);
+    }
+    return result;
+}
+
+CatalogueStats EventRepository::stats() const {
+    CatalogueStats stats;
+    stats.events = live_;
+    for (int i = 0; i < EVENT_STATUS_COUNT; i++) stats.byStatus[i] = statuses_.count(static_cast<EventStatus>(i));
+    stats.attendees = attendeeTotal_;
+    stats.revenue = revenue_;
+    return stats;
+}
+
+vector<const Event*> EventRepository::byOrganizer(int organizerId) const {
+    auto it = eventIdsByOrganizer_.find(organizerId);
+    return it == eventIdsByOrganizer_.end() ? vector<const Event*>() : inCatalogueOrder(it->second);
+}
+
+vector<const Event*> EventRepository::byStatus(EventStatus status) const {
+    vector<const Event*> result;
+    for (size_t slot : statuses_.slotsWith(status)) result.push_back(slots_[slot].get());
+    return result;
+}
+
+vector<const Event*> EventRepository::byAttendee(int userId) const {
+    return inCatalogueOrder(registrations_.eventsOf(userId));
+}
+
+vector<const Event*> EventRepository::between(CalendarDay from, CalendarDay to) const {
+    vector<const Event*> result;
+    // Removed slots and undated events have no date, which sorts before any real one
+    if (from.empty() || to < from) return result;
+    for (size_t slot = 0; slot < dates_.size(); slot++) {
+        if (dates_[slot] >= from && dates_[slot] <= to) result.push_back(slots_[slot].get());
+    }
+    return result;
+}
+
+const Event& EventRepository::put(Event ev) {
+    size_t slot = slotOf(ev.id);
+    if (slot < slots_.size()) {
+        Event* existing = slots_[slot].get();
+        schedule_.remove(*existing);
+        search_.remove(*existing);
+        leaderboard_.remove(*existing);
+        registrations_.removeEvent(*existing);
+        unindexOrganizer(*existing);
+        countEvent(*existing, false);
+        EventStatus previousStatus = existing->status;
+        *existing = move(ev);
+        schedule_.add(*existing);
+        search_.add(*existing);
+        leaderboard_.add(*existing);
+        registrations_.addEvent(*existing);
+        indexOrganizer(*existing);
+        countEvent(*existing, true);
+        statuses_.move(slot, previousStatus, existing->status);
+        dates_[slot] = existing->date;
+        capacities_[slot] = existing->expectedParticipants;
+        seats_[slot].reset(existing->attendees.size());
+        return *existing;
+    }
+
+    if (ev.id > maxId_) maxId_ = ev.id;
+    slotById_[ev.id] = slots_.size();
+    dates_.push_back(ev.date);
+    capacities_.push_back(ev.expectedParticipants);
+    seats_.emplace_back();
+    seats_.back().reset(ev.attendees.size());
+    slots_.push_back(unique_ptr<Event>(new Event(move(ev))));
+    schedule_.add(*slots_.back());
+    search_.add(*slots_.back());
+    leaderboard_.add(*slots_.back());
+    registrations_.addEvent(*slots_.back());
+    indexOrganizer(*slots_.back());
+    countEvent(*slots_.back(), true);
+    statuses_.add(slots_.size() - 1, slots_.back()->status);
+    live_++;
+    return *slots_.back();
+}
+
+bool EventRepository::remove(int id) {
+    auto it = slotById_.find(id);
+    if (it == slotById_.end()) return false;
+
+    schedule_.remove(*slots_[it->second]);
+    search_.remove(*slots_[it->second]);
+    leaderboard_.remove(*slots_[it->second]);
+    registrations_.removeEvent(*slots_[it->second]);
+    unindexOrganizer(*slots_[it->second]);
+    countEvent(*slots_[it->second], false);
+    statuses_.remove(it->second, slots_[it->second]->status);
+    dates_[it->second] = CalendarDay();
+    capacities_[it->second] = 0;
+    seats_[it->second].reset(0);
+    slots_[it->second].reset();
+    slotById_.erase(it);
+    live_--;
+
+    size_t tombstones = slots_.size() - live_;
+    if (tombstones >= MIN_TOMBSTONES_TO_COMPACT && tombstones > live_) {
+        compactSlots();
+    }
+    return true;
+}
+
+void EventRepository::compactSlots() {
+    // Only the slot vector moves; the Event objects (and handles to them) stay put
+    size_t out = 0;
+    for (size_t i = 0; i < slots_.size(); i++) {
+        if (!slots_[i]) continue;
+        slots_[out] = move(slots_[i]);
+        slotById_[slots_[out]->id] = out;
+        dates_[out] = dates_[i];
+        capacities_[out] = capacities_[i];
+        seats_[out] = seats_[i];
+        out++;
+    }
+    slots_.resize(out);
+    dates_.resize(out);
+    capacities_.resize(out);
+    seats_.resize(out);
+
+    // Slot numbers changed, so the status bitsets are rebuilt
+    statuses_.clear();
+    for (size_t i = 0; i < slots_.size(); i++) statuses_.add(i, slots_[i]->status);
+}
+
+bool EventRepository::addAttendee(int id, int userId) {
+    size_t slot = slotOf(id);
+    if (slot == slots_.size()) return false;
+    Event* ev = slots_[slot].get();
+    if (ev->attendees.contains(userId)) return false;
+    leaderboard_.remove(*ev);
+    ev->attendees.insert(userId);
+    seats_[slot].add();
+    attendeeTotal_++;
+    leaderboard_.add(*ev);
+    registrations_.add(userId, id);
+    return true;
+}
+
+bool EventRepository::reserveSeat(int id) {
+    size_t slot = slotOf(id);
+    return slot < slots_.size() && seats_[slot].reserve(capacities_[slot]);
+}
+
+void EventRepository::releaseSeat(int id) {
+    size_t slot = slotOf(id);
+    if (slot < slots_.size()) seats_[slot].release();
+}
+
+bool EventRepository::commitSeat(int id, int userId) {
+    size_t slot = slotOf(id);
+    if (slot == slots_.size()) return false;
+    Event* ev = slots_[slot].get();
+    if (ev->attendees.contains(userId)) {
+        seats_[slot].release();
+        return false;
+    }
+    leaderboard_.remove(*ev);
+    ev->attendees.insert(userId);
+    seats_[slot].commit();
+    attendeeTotal_++;
+    leaderboard_.add(*ev);
+    registrations_.add(userId, id);
+    return true;
+}
+
+int EventRepository::seatsLeft(int id) const {
+    size_t slot = slotOf(id);
+    return slot < slots_.size() ? seats_[slot].available(capacities_[slot]) : 0;
+}
+
+const SeatCounter* EventRepository::seats(int id) const {
+    size_t slot = slotOf(id);
+    return slot < slots_.size() ? &seats_[slot] : nullptr;
+}
+
+bool EventRepository::removeAttendee(int id, int userId) {
+    size_t slot = slotOf(id);
+    if (slot == slots_.size()) return false;
+    Event* ev = slots_[slot].get();
+    if (!ev->attendees.contains(userId)) return false;
+    leaderboard_.remove(*ev);
+    ev->attendees.erase(userId);
+    seats_[slot].remove();
+    attendeeTotal_--;
+    leaderboard_.add(*ev);
+    registrations_.remove(userId, id);
+    return true;
+}
+
+bool EventRepository::setStatus(int id, EventStatus status) {
+    auto it = slotById_.find(id);
+    if (it == slotById_.end()) return false;
+    Event* ev = slots_[it->second].get();
+    statuses_.move(it->second, ev->status, status);
+    ev->status = status;
+    return true;
+}
+
+bool EventRepository::setMarketing(int id, const string& marketing) {
+    Event* ev = slotFor(id);
+    if (!ev) return false;
+    ev->marketing = marketing;
+    return true;
+}
+
+bool EventRepository::putRating(int id, const Rating& rating) {
+    Event* ev = slotFor(id);
+    if (!ev) return false;
+    leaderboard_.remove(*ev);
+
+    bool updated = false;
+    for (Rating& r : ev->ratings) {
+        if (r.attendeeId == rating.attendeeId) {
+            double old = r.rating;
+            r = rating;
+            ev->ratingStats.remove(old, ev->ratings);
+            updated = true;
+            break;
+        }
+    }
+    if (!updated) ev->ratings.push_back(rating);
+
+    ev->ratingStats.add(rating.rating);
+    ev->averageRating = ev->ratingStats.mean();
+    leaderboard_.add(*ev);
+    return true;
+}
+
+bool EventRepository::removeRating(int id, int attendeeId) {
+    Event* ev = slotFor(id);
+    if (!ev) return false;
+    for (auto it = ev->ratings.begin(); it != ev->ratings.end(); ++it) {
+        if (it->attendeeId == attendeeId) {
+            double old = it->rating;
+            leaderboard_.remove(*ev);
+            ev->ratings.erase(it);
+            ev->ratingStats.remove(old, ev->ratings);
+            ev->averageRating = ev->ratingStats.mean();
+            leaderboard_.add(*ev);
+            return true;
+        }
+    }
+    return false;
+}
+
+RatingStats EventRepository::ratingStatsFor(int organizerId) const {
+    RatingStats total;
+    for (const Event* ev : byOrganizer(organizerId)) total.merge(ev->ratingStats);
+    return total;
+}
+
+RatingStats EventRepository::ratingStatsAll() const {
+    RatingStats total;
+    for (const Event& ev : *this) total.merge(ev.ratingStats);
+    return total;
+}
+
+void EventRepository::removeUser(int userId) {
+    auto organized = eventIdsByOrganizer_.find(userId);
+    if (organized != eventIdsByOrganizer_.end()) {
+        vector<int> orphaned = move(organized->second);
+        eventIdsByOrganizer_.erase(organized);
+        for (int eventId : orphaned) {
+            if (Event* ev = slotFor(eventId)) ev->organizerId = -1;
+        }
+        vector<int>& unowned = eventIdsByOrganizer_[-1];
+        unowned.insert(unowned.end(), orphaned.begin(), orphaned.end());
+    }
+    for (int eventId : registrations_.removeUser(userId)) {
+        size_t slot = slotOf(eventId);
+        if (slot == slots_.size()) continue;
+        Event* ev = slots_[slot].get();
+        leaderboard_.remove(*ev);
+        ev->attendees.erase(userId);
+        seats_[slot].remove();
+        attendeeTotal_--;
+        leaderboard_.add(*ev);
+    }
+}
+
+int generateEventId(const EventRepository& events) {
+    return events.maxId() + 1;
+}
@@ -0,0 +1,170 @@
+#pragma once
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "event.h"
+#include "leaderboard.h"
+#include "registrationindex.h"
+#include "scheduleindex.h"
+#include "searchindex.h"
+#include "statusindex.h"
+
+using namespace std;
+
+const size_t SEARCH_RESULT_LIMIT = 50;
+
+// Dashboard counters over the whole catalogue
+struct CatalogueStats {
+    size_t events = 0;
+    size_t byStatus[EVENT_STATUS_COUNT] = {};     // indexed by EventStatus
+    size_t attendees = 0;                         // registrations across every event
+    double revenue = 0.0;                         // fees paid for every stored event
+};
+
+// Owns every Event in the system.
+//
+// Each event lives in its own heap slot, so the const Event* returned by
+// find() is a stable handle: it stays valid until that event is removed,
+// no matter how many other events are added or removed. Lookups by id are
+// O(1). Iteration visits events in insertion order.
+//
+// Callers only get const access; every change goes through a mutator below so
+// the repository can keep its indexes consistent.
+//
+// The date and capacity that whole-catalogue scans and the seat checks read
+// are mirrored into packed columns indexed by slot, so those paths stream
+// through a small array instead of pulling each event's strings, attendees
+// and ratings through the cache. The Event stays the source of truth: the
+// columns are copies that put() refreshes, not a hot/cold split. Only the
+// seat counters live in a column alone.
+class EventRepository {
+public:
+    class const_iterator {
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = Event;
+        using difference_type = ptrdiff_t;
+        using pointer = const Event*;
+        using reference = const Event&;
+
+        const_iterator() = default;
+        const_iterator(const unique_ptr<Event>* pos, const unique_ptr<Event>* end) : pos_(pos), end_(end) { skipEmpty(); }
+
+        reference operator*() const { return **pos_; }
+        pointer operator->() const { return pos_->get(); }
+        const_iterator& operator++() { ++pos_; skipEmpty(); return *this; }
+        const_iterator operator++(int) { const_iterator old = *this; ++*this; return old; }
+        bool operator==(const const_iterator& other) const { return pos_ == other.pos_; }
+        bool operator!=(const const_iterator& other) const { return pos_ != other.pos_; }
+
+    private:
+        void skipEmpty() { while (pos_ != end_ && !*pos_) ++pos_; }
+
+        const unique_ptr<Event>* pos_ = nullptr;
+        const unique_ptr<Event>* end_ = nullptr;
+    };
+
+    const_iterator begin() const { return const_iterator(slots_.data(), slots_.data() + slots_.size()); }
+    const_iterator end() const { return const_iterator(slots_.data() + slots_.size(), slots_.data() + slots_.size()); }
+    size_t size() const { return live_; }
+    bool empty() const { return live_ == 0; }
+
+    // Replaces the whole contents (used after loading a snapshot)
+    void load(vector<Event>&& loaded);
+    void clear();
+
+    const Event* find(int id) const;
+    int maxId() const { return maxId_; }
+
+    // Events run by the organizer (-1 = orphaned by a user delete), in catalogue order
+    vector<const Event*> byOrganizer(int organizerId) const;
+    bool hasEventsBy(int organizerId) const { return eventIdsByOrganizer_.count(organizerId) != 0; }
+    // Only touches events with that status, in catalogue order
+    vector<const Event*> byStatus(EventStatus status) const;
+    size_t countByStatus(EventStatus status) const { return statuses_.count(status); }
+    // Events the user is registered for, in catalogue order
+    vector<const Event*> byAttendee(int userId) const;
+    // Events dated from..to inclusive, in catalogue order; a scan of the date column
+    vector<const Event*> between(CalendarDay from, CalendarDay to) const;
+
+    // Venue/date/slot bookings for conflict checks and availability
+    const ScheduleIndex& schedule() const { return schedule_; }
+    // Events ranked by attendees / rating / recency for the top-event banner
+    const Leaderboard& leaderboard() const { return leaderboard_; }
+    // Keyword/prefix search over title, description, location and package,
+    // best match first
+    vector<const Event*> search(string_view query, size_t limit = SEARCH_RESULT_LIMIT) const;
+    // O(1): the counters are updated by every mutator
+    CatalogueStats stats() const;
+
+    // Inserts a new event or replaces the one with the same id
+    const Event& put(Event ev);
+    bool remove(int id);
+
+    // Adds without a capacity check (loading, journal replay)
+    bool addAttendee(int id, int userId);
+    bool removeAttendee(int id, int userId);
+
+    // Capacity-checked registration: reserveSeat claims one of the event's
+    // expectedParticipants seats without locking, then commitSeat adds the
+    // attendee or releaseSeat gives the seat back. commitSeat releases the
+    // seat itself when the attendee was already registered.
+    bool reserveSeat(int id);
+    void releaseSeat(int id);
+    bool commitSeat(int id, int userId);
+    int seatsLeft(int id) const;
+    // nullptr if there is no such event
+    const SeatCounter* seats(int id) const;
+    bool setStatus(int id, EventStatus status);
+    bool setMarketing(int id, const string& marketing);
+    // Inserts or replaces the attendee's rating; averageRating and
+    // ratingStats are updated incrementally
+    bool putRating(int id, const Rating& rating);
+    bool removeRating(int id, int attendeeId);
+
+    // Rating aggregates across one organizer's events / every event
+    RatingStats ratingStatsFor(int organizerId) const;
+    RatingStats ratingStatsAll() const;
+
+    // Cascade for a deleted user: orphan their events and drop their registrations
+    void removeUser(int userId);
+
+private:
+    Event* slotFor(int id);
+    // slots_.size() if there is no such event
+    size_t slotOf(int id) const;
+    void compactSlots();
+    vector<const Event*> inCatalogueOrder(const vector<int>& ids) const;
+    void indexOrganizer(const Event& ev);
+    void unindexOrganizer(const Event& ev);
+    void countEvent(const Event& ev, bool added);
+
+    vector<unique_ptr<Event>> slots_;
+    unordered_map<int, size_t> slotById_;
+    // Hot columns, one entry per slot. A removed slot has no date and no
+    // seats. Only put(), remove() and compaction resize them, so the seat
+    // counters can be claimed in parallel like the other per-event data.
+    vector<CalendarDay> dates_;     // copy of Event::date
+    vector<int> capacities_;        // copy of Event::expectedParticipants
+    vector<SeatCounter> seats_;     // not persisted; rebuilt from attendees
+    ScheduleIndex schedule_;
+    SearchIndex search_;
+    Leaderboard leaderboard_;
+    RegistrationIndex registrations_;
+    StatusIndex statuses_;
+    // Only put(), remove() and removeUser() change an organizer, and the
+    // server runs those alone, so unlike the leaderboard, registration and
+    // status indexes this needs no lock
+    unordered_map<int, vector<int>> eventIdsByOrganizer_;
+    // Registrations run in parallel on --serve, hence atomic; revenue only
+    // changes with put() and remove()
+    atomic<size_t> attendeeTotal_{ 0 };
+    double revenue_ = 0.0;
+    size_t live_ = 0;
+    int maxId_ = 0;
+};
+
+int generateEventId(const EventRepository& events);
@@ -0,0 +1,186 @@
+#include "eventservice.h"
+#include <algorithm>
+#include "helpers.h"
+#include "journal.h"
+
+using namespace std;
+
+static ServiceResult failure(ServiceError error, const char* message) {
+    ServiceResult result;
+    result.error = error;
+    result.message = message;
+    return result;
+}
+
+int venueCost(const string& location) {
+    for (const Hall& hall : HALLS) {
+        if (location == hall.name) return hall.cost;
+    }
+    return 0;
+}
+
+ServiceResult EventService::registerUser(User& user) {
+    if (user.username.empty()) return failure(ServiceError::INVALID, "username cannot be empty");
+    if (findUserByUsername(user.username)) return failure(ServiceError::DUPLICATE, "username already exists");
+    if (user.password.size() < 4) return failure(ServiceError::INVALID, "password must be at least 4 characters long");
+    if (user.role != ROLE_ADMIN && user.role != ROLE_ORGANIZER && user.role != ROLE_ATTENDEE) {
+        return failure(ServiceError::INVALID, "role must be admin, organizer or attendee");
+    }
+    if (user.name.empty()) return failure(ServiceError::INVALID, "name cannot be empty");
+    if (!isValidEmail(user.email)) return failure(ServiceError::INVALID, "invalid email format");
+
+    user.id = generateUserId();
+    addUser(user);
+    journalUserPut(user);
+    return ServiceResult();
+}
+
+ServiceResult EventService::deleteUser(int userId) {
+    if (!findUserById(userId)) return failure(ServiceError::NOT_FOUND, "user not found");
+
+    events_.removeUser(userId);
+    ::deleteUser(userId);
+    journalUserDelete(userId);
+    return ServiceResult();
+}
+
+ServiceResult EventService::quoteEvent(Event& ev) const {
+    const Event* stored = events_.find(ev.id);
+    // An unchanged date or time is kept as stored, even legacy text the
+    // current rules reject, so such an event can still be edited
+    bool sameDate = stored && ev.date == stored->date && ev.legacyDate == stored->legacyDate;
+    bool sameTime = stored && ev.time == stored->time && ev.legacyTime == stored->legacyTime;
+    if (!sameDate && !isValidDate(ev.date)) {
+        return failure(ServiceError::INVALID, "invalid date (YYYY-MM-DD, 2025-01-01 to 2028-12-31)");
+    }
+    if (!sameTime && static_cast<int>(ev.time) >= TIME_SLOT_COUNT) {
+        return failure(ServiceError::INVALID, "unknown time slot");
+    }
+    int cost = venueCost(ev.location);
+    if (cost == 0) return failure(ServiceError::INVALID, "unknown location");
+    if (ev.expectedParticipants < 1 || ev.expectedParticipants > 100) {
+        return failure(ServiceError::INVALID, "participants must be 1-100");
+    }
+    if (stored && ev.expectedParticipants < static_cast<int>(stored->attendees.size())) {
+        return failure(ServiceError::INVALID, "participants cannot drop below the attendees already registered");
+    }
+    // Without a real date and slot (legacy text) there is no booking to clash with
+    bool booked = !ev.date.empty() && ev.time != TimeSlot::NONE;
+    if (booked && !events_.schedule().isFree(ev.location, ev.date, ev.time, ev.id)) {
+        return failure(ServiceError::CONFLICT, "slot and location already taken");
+    }
+
+    ev.totalFee = calculateTotalFee(cost, ev.expectedParticipants, ev.themeCost);
+    return ServiceResult();
+}
+
+ServiceResult EventService::createEvent(Event& ev) {
+    const User* organizer = findUserById(ev.organizerId);
+    if (!organizer || organizer->role != ROLE_ORGANIZER) return failure(ServiceError::NOT_FOUND, "organizer not found");
+
+    ev.id = 0;
+    ServiceResult result = quoteEvent(ev);
+    if (!result.ok()) return result;
+
+    ev.id = generateEventId(events_);
+    journalEventPut(events_.put(ev));
+    return result;
+}
+
+ServiceResult EventService::updateEvent(Event& ev, int organizerId) {
+    ServiceResult result;
+    const Event* stored = ownedEvent(ev.id, organizerId, result);
+    if (!stored) return result;
+
+    ev.organizerId = stored->organizerId;
+    ev.attendees = stored->attendees;
+    ev.status = stored->status;
+    ev.marketing = stored->marketing;
+    ev.ratings = stored->ratings;
+    ev.averageRating = stored->averageRating;
+    ev.ratingStats = stored->ratingStats;
+
+    result = quoteEvent(ev);
+    if (!result.ok()) return result;
+
+    journalEventPut(events_.put(ev));
+    return result;
+}
+
+ServiceResult EventService::deleteEvent(int eventId, int organizerId) {
+    ServiceResult result;
+    if (!ownedEvent(eventId, organizerId, result)) return result;
+
+    events_.remove(eventId);
+    journalEventDelete(eventId);
+    return result;
+}
+
+ServiceResult EventService::registerAttendee(int eventId, int attendeeId, int organizerId) {
+    ServiceResult result;
+    const Event* ev = ownedEvent(eventId, organizerId, result);
+    if (!ev) return result;
+
+    const User* attendee = findUserById(attendeeId);
+    if (!attendee || attendee->role != ROLE_ATTENDEE) return failure(ServiceError::NOT_FOUND, "attendee not found");
+    if (ev->status != EventStatus::UPCOMING) return failure(ServiceError::WRONG_STATUS, "event is not UPCOMING");
+    if (ev->attendees.contains(attendeeId)) {
+        return failure(ServiceError::DUPLICATE, "already registered");
+    }
+    if (!events_.reserveSeat(eventId)) return failure(ServiceError::FULL, "event is full");
+    if (!events_.commitSeat(eventId, attendeeId)) return failure(ServiceError::DUPLICATE, "already registered");
+
+    journalAttendeeAdd(eventId, attendeeId);
+    return result;
+}
+
+ServiceResult EventService::cancelRegistration(int eventId, int attendeeId) {
+    if (!events_.find(eventId)) return failure(ServiceError::NOT_FOUND, "event not found");
+    if (!events_.removeAttendee(eventId, attendeeId)) return failure(ServiceError::NOT_FOUND, "not registered");
+
+    journalAttendeeRemove(eventId, attendeeId);
+    return ServiceResult();
+}
+
+ServiceResult EventService::setStatus(int eventId, EventStatus status) {
+    if (!events_.setStatus(eventId, status)) return failure(ServiceError::NOT_FOUND, "event not found");
+
+    journalStatusSet(eventId, status);
+    return ServiceResult();
+}
+
+ServiceResult EventService::setMarketing(int eventId, const string& marketing, int organizerId) {
+    ServiceResult result;
+    if (!ownedEvent(eventId, organizerId, result)) return result;
+
+    events_.setMarketing(eventId, marketing);
+    journalMarketingSet(eventId, marketing);
+    return result;
+}
+
+ServiceResult EventService::rateEvent(int eventId, const Rating& rating) {
+    const Event* ev = events_.find(eventId);
+    if (!ev) return failure(ServiceError::NOT_FOUND, "event not found");
+    if (ev->status != EventStatus::COMPLETED) return failure(ServiceError::WRONG_STATUS, "only COMPLETED events can be rated");
+    if (!ev->attendees.contains(rating.attendeeId)) {
+        return failure(ServiceError::NOT_PERMITTED, "attendee did not attend this event");
+    }
+    if (rating.rating < 1.0 || rating.rating > 5.0) return failure(ServiceError::INVALID, "rating must be 1.0-5.0");
+
+    events_.putRating(eventId, rating);
+    journalRatingPut(eventId, rating, ev->averageRating);
+    return ServiceResult();
+}
+
+const Event* EventService::ownedEvent(int eventId, int organizerId, ServiceResult& result) const {
+    const Event* ev = events_.find(eventId);
+    if (!ev) {
+        result = failure(ServiceError::NOT_FOUND, "event not found");
+        return nullptr;
+    }
+    if (organizerId != ANY_ORGANIZER && ev->organizerId != organizerId) {
+        result = failure(ServiceError::NOT_PERMITTED, "event belongs to another organizer");
+        return nullptr;
+    }
+    return ev;
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <string>
+#include "event.h"
+#include "eventrepository.h"
+#include "user.h"
+
+using namespace std;
+
+enum class ServiceError {
+    NONE,
+    NOT_FOUND,          // event or user does not exist
+    NOT_PERMITTED,      // caller does not own the event / user has the wrong role
+    INVALID,            // a field is out of range or badly formatted
+    CONFLICT,           // venue, date and slot are already booked
+    DUPLICATE,          // already registered / username taken
+    FULL,               // every seat (expectedParticipants) is taken
+    WRONG_STATUS        // the event's status does not allow this
+};
+
+// Outcome of a service call. `message` is a string literal.
+struct ServiceResult {
+    ServiceError error = ServiceError::NONE;
+    const char* message = "";
+
+    bool ok() const { return error == ServiceError::NONE; }
+};
+
+struct Hall {
+    const char* name;
+    int cost;           // RM per booking
+};
+
+const int HALL_COUNT = 3;
+const Hall HALLS[HALL_COUNT] = {
+    { "1st Floor Banquet Hall", 50 },
+    { "2nd Floor Banquet Hall", 75 },
+    { "3rd Floor Banquet Hall", 100 }
+};
+
+// 0 for an unknown location
+int venueCost(const string& location);
+
+// Passed as organizerId when the caller may act on any event (admin, batch)
+const int ANY_ORGANIZER = -1;
+
+// The business rules behind the menus, with no terminal I/O.
+//
+// Every call validates its input, applies the change to the repository and
+// appends it to the journal, or leaves everything untouched and says why.
+// The menus, batch mode and benchmarks all go through here, so a rule only
+// has to be written once. Payment is the caller's business: quote first,
+// take the money, then create/update.
+class EventService {
+public:
+    explicit EventService(EventRepository& events) : events_(events) {}
+
+    // Assigns user.id on success
+    ServiceResult registerUser(User& user);
+    // Orphans the user's events and drops their registrations
+    ServiceResult deleteUser(int userId);
+
+    // Checks the booking and fills in ev.totalFee without saving anything
+    ServiceResult quoteEvent(Event& ev) const;
+    // Assigns ev.id on success
+    ServiceResult createEvent(Event& ev);
+    // Replaces the details of an existing event. Attendees, ratings, status
+    // and marketing are kept from the stored event.
+    ServiceResult updateEvent(Event& ev, int organizerId);
+    ServiceResult deleteEvent(int eventId, int organizerId = ANY_ORGANIZER);
+
+    ServiceResult registerAttendee(int eventId, int attendeeId, int organizerId = ANY_ORGANIZER);
+    ServiceResult cancelRegistration(int eventId, int attendeeId);
+    ServiceResult setStatus(int eventId, EventStatus status);
+    ServiceResult setMarketing(int eventId, const string& marketing, int organizerId = ANY_ORGANIZER);
+    // Inserts or replaces rating.attendeeId's rating
+    ServiceResult rateEvent(int eventId, const Rating& rating);
+
+private:
+    // The event if it exists and organizerId may change it
+    const Event* ownedEvent(int eventId, int organizerId, ServiceResult& result) const;
+
+    EventRepository& events_;
+};
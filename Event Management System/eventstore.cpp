@@ -0,0 +1,349 @@
+#include "eventstore.h"
+#include <cstring>
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+#include "mappedfile.h"
+
+using namespace std;
+
+static const char EVENT_STORE_MAGIC[4] = { 'E', 'V', 'T', 'B' };
+
+// ---------- encoding ----------
+
+static void putBytes(vector<char>& buf, const void* data, size_t size) {
+    const char* p = static_cast<const char*>(data);
+    buf.insert(buf.end(), p, p + size);
+}
+
+template <typename T>
+static void putValue(vector<char>& buf, T value) {
+    putBytes(buf, &value, sizeof(T));
+}
+
+template <typename T, typename Events, typename Getter>
+static void putColumn(vector<char>& buf, const Events& events, Getter get) {
+    for (const Event& ev : events) putValue<T>(buf, static_cast<T>(get(ev)));
+}
+
+template <typename Events, typename Getter>
+static void putStringColumn(vector<char>& buf, const Events& events, Getter get) {
+    for (const Event& ev : events) putValue<uint32_t>(buf, static_cast<uint32_t>(get(ev).size()));
+    for (const Event& ev : events) {
+        const string& s = get(ev);
+        putBytes(buf, s.data(), s.size());
+    }
+}
+
+// ---------- decoding ----------
+
+struct StoreReader {
+    const char* cur;
+    const char* end;
+
+    void need(size_t size) const {
+        if (static_cast<size_t>(end - cur) < size) {
+            throw runtime_error("unexpected end of file");
+        }
+    }
+
+    template <typename T>
+    T value() {
+        need(sizeof(T));
+        T v;
+        memcpy(&v, cur, sizeof(T));
+        cur += sizeof(T);
+        return v;
+    }
+
+    template <typename T>
+    vector<T> column(size_t count) {
+        need(count * sizeof(T));
+        vector<T> out(count);
+        if (count > 0) memcpy(out.data(), cur, count * sizeof(T));
+        cur += count * sizeof(T);
+        return out;
+    }
+
+    void strings(size_t count, vector<string>& out) {
+        vector<uint32_t> lengths = column<uint32_t>(count);
+        out.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            need(lengths[i]);
+            out[i].assign(cur, lengths[i]);
+            cur += lengths[i];
+        }
+    }
+};
+
+// ---------- writing ----------
+
+// Works on any container of Event that can be iterated twice (vector or EventRepository)
+template <typename Events>
+static bool writeEventStore(const Events& events, const string& filename) {
+    vector<char> buf;
+    buf.reserve(64 + events.size() * 256);
+
+    putBytes(buf, EVENT_STORE_MAGIC, sizeof(EVENT_STORE_MAGIC));
+    putValue<uint32_t>(buf, EVENT_STORE_VERSION);
+    putValue<uint64_t>(buf, events.size());
+
+    putColumn<int32_t>(buf, events, [](const Event& e) { return e.id; });
+    putColumn<int32_t>(buf, events, [](const Event& e) { return e.organizerId; });
+    putColumn<int32_t>(buf, events, [](const Event& e) { return e.expectedParticipants; });
+    putColumn<uint8_t>(buf, events, [](const Event& e) { return static_cast<int>(e.status); });
+    putColumn<double>(buf, events, [](const Event& e) { return e.totalFee; });
+    putColumn<double>(buf, events, [](const Event& e) { return e.themeCost; });
+    putColumn<double>(buf, events, [](const Event& e) { return e.averageRating; });
+    putColumn<int32_t>(buf, events, [](const Event& e) { return e.date.days(); });
+    putColumn<uint8_t>(buf, events, [](const Event& e) { return static_cast<int>(e.time); });
+
+    putStringColumn(buf, events, [](const Event& e) -> const string& { return e.title; });
+    putStringColumn(buf, events, [](const Event& e) -> const string& { return e.description; });
+    putStringColumn(buf, events, [](const Event& e) -> const string& { return e.location; });
+    putStringColumn(buf, events, [](const Event& e) -> const string& { return e.themeName; });
+    putStringColumn(buf, events, [](const Event& e) -> const string& { return e.vendorName; });
+    putStringColumn(buf, events, [](const Event& e) -> const string& { return e.marketing; });
+    putStringColumn(buf, events, [](const Event& e) -> const string& { return e.legacyDate; });
+    putStringColumn(buf, events, [](const Event& e) -> const string& { return e.legacyTime; });
+
+    // Attendees: per-event counts, then every id packed back to back
+    putColumn<uint32_t>(buf, events, [](const Event& e) { return e.attendees.size(); });
+    for (const Event& ev : events) {
+        for (int id : ev.attendees) putValue<int32_t>(buf, id);
+    }
+
+    // Ratings: per-event counts, then one packed column per rating field
+    putColumn<uint32_t>(buf, events, [](const Event& e) { return e.ratings.size(); });
+    for (const Event& ev : events)
+        for (const Rating& r : ev.ratings) putValue<int32_t>(buf, r.attendeeId);
+    for (const Event& ev : events)
+        for (const Rating& r : ev.ratings) putValue<double>(buf, r.rating);
+    for (const Event& ev : events)
+        for (const Rating& r : ev.ratings) putValue<uint32_t>(buf, static_cast<uint32_t>(r.comment.size()));
+    for (const Event& ev : events)
+        for (const Rating& r : ev.ratings) putBytes(buf, r.comment.data(), r.comment.size());
+    for (const Event& ev : events)
+        for (const Rating& r : ev.ratings) putValue<uint32_t>(buf, static_cast<uint32_t>(r.complaint.size()));
+    for (const Event& ev : events)
+        for (const Rating& r : ev.ratings) putBytes(buf, r.complaint.data(), r.complaint.size());
+
+    // Rating aggregates (the count is the ratings count column above)
+    putColumn<double>(buf, events, [](const Event& e) { return e.ratingStats.sum; });
+    putColumn<double>(buf, events, [](const Event& e) { return e.ratingStats.min; });
+    putColumn<double>(buf, events, [](const Event& e) { return e.ratingStats.max; });
+    for (int star = 0; star < RATING_STARS; star++) {
+        putColumn<uint32_t>(buf, events, [star](const Event& e) { return e.ratingStats.histogram[star]; });
+    }
+
+    // Write to a temporary file first so a crash never leaves a torn store
+    string tmpName = filename + ".tmp";
+    {
+        ofstream outFile(tmpName, ios::binary | ios::trunc);
+        if (!outFile) {
+            cerr << "Error: Cannot open " << tmpName << " for writing!" << endl;
+            return false;
+        }
+        outFile.write(buf.data(), static_cast<streamsize>(buf.size()));
+        if (!outFile) {
+            cerr << "Error: Failed writing " << tmpName << endl;
+            return false;
+        }
+    }
+    // Replaces the old store in one step, so there is always a whole store on disk
+    if (!replaceFile(tmpName, filename)) {
+        cerr << "Error: Cannot replace " << filename << endl;
+        return false;
+    }
+    return true;
+}
+
+// ---------- public API ----------
+
+bool saveEventsToBinaryFile(const vector<Event>& events, const string& filename) {
+    return writeEventStore(events, filename);
+}
+
+bool saveEventsToBinaryFile(const EventRepository& events, const string& filename) {
+    return writeEventStore(events, filename);
+}
+
+StoreLoad loadEventsFromBinaryFile(vector<Event>& events, const string& filename) {
+    ifstream inFile(filename, ios::binary | ios::ate);
+    if (!inFile) {
+        return StoreLoad::MISSING;
+    }
+
+    streamsize size = inFile.tellg();
+    inFile.seekg(0);
+    vector<char> buf(static_cast<size_t>(size));
+    if (size > 0 && !inFile.read(buf.data(), size)) {
+        cerr << "Error: Cannot read " << filename << endl;
+        return StoreLoad::INVALID;
+    }
+
+    try {
+        StoreReader in{ buf.data(), buf.data() + buf.size() };
+
+        in.need(sizeof(EVENT_STORE_MAGIC));
+        if (memcmp(in.cur, EVENT_STORE_MAGIC, sizeof(EVENT_STORE_MAGIC)) != 0) {
+            throw runtime_error("bad magic");
+        }
+        in.cur += sizeof(EVENT_STORE_MAGIC);
+
+        uint32_t version = in.value<uint32_t>();
+        if (version < 1 || version > EVENT_STORE_VERSION) {
+            throw runtime_error("unsupported version " + to_string(version));
+        }
+
+        uint64_t count64 = in.value<uint64_t>();
+        // Every event needs at least its fixed-width columns, so this bounds a corrupt count
+        if (count64 > buf.size()) {
+            throw runtime_error("bad event count");
+        }
+        size_t n = static_cast<size_t>(count64);
+
+        vector<int32_t> ids = in.column<int32_t>(n);
+        vector<int32_t> organizerIds = in.column<int32_t>(n);
+        vector<int32_t> expected = in.column<int32_t>(n);
+        vector<uint8_t> statuses = in.column<uint8_t>(n);
+        vector<double> totalFees = in.column<double>(n);
+        vector<double> themeCosts = in.column<double>(n);
+        vector<double> averages = in.column<double>(n);
+
+        // v3 stores the packed day and slot; older stores have them as text
+        bool packedDates = version >= 3;
+        vector<int32_t> days;
+        vector<uint8_t> slots;
+        if (packedDates) {
+            days = in.column<int32_t>(n);
+            slots = in.column<uint8_t>(n);
+        }
+
+        vector<string> titles, descriptions, dates, times, locations, themeNames, vendorNames, marketing;
+        in.strings(n, titles);
+        in.strings(n, descriptions);
+        if (!packedDates) {
+            in.strings(n, dates);
+            in.strings(n, times);
+        }
+        in.strings(n, locations);
+        in.strings(n, themeNames);
+        in.strings(n, vendorNames);
+        in.strings(n, marketing);
+        // Unparsed date/time text, in the columns the older layout used for all of it
+        if (version >= 4) {
+            in.strings(n, dates);
+            in.strings(n, times);
+        }
+
+        vector<uint32_t> attendeeCounts = in.column<uint32_t>(n);
+        size_t totalAttendees = 0;
+        for (uint32_t c : attendeeCounts) totalAttendees += c;
+        vector<int32_t> attendeeIds = in.column<int32_t>(totalAttendees);
+
+        vector<uint32_t> ratingCounts = in.column<uint32_t>(n);
+        size_t totalRatings = 0;
+        for (uint32_t c : ratingCounts) totalRatings += c;
+        vector<int32_t> ratingAttendees = in.column<int32_t>(totalRatings);
+        vector<double> ratingValues = in.column<double>(totalRatings);
+        vector<string> comments, complaints;
+        in.strings(totalRatings, comments);
+        in.strings(totalRatings, complaints);
+
+        bool hasStats = version >= 2;
+        vector<double> ratingSums, ratingMins, ratingMaxes;
+        vector<uint32_t> histograms[RATING_STARS];
+        if (hasStats) {
+            ratingSums = in.column<double>(n);
+            ratingMins = in.column<double>(n);
+            ratingMaxes = in.column<double>(n);
+            for (int star = 0; star < RATING_STARS; star++) histograms[star] = in.column<uint32_t>(n);
+        }
+
+        vector<Event> loaded(n);
+        size_t attendeePos = 0, ratingPos = 0;
+        for (size_t i = 0; i < n; i++) {
+            Event& ev = loaded[i];
+            ev.id = ids[i];
+            ev.organizerId = organizerIds[i];
+            ev.expectedParticipants = expected[i];
+            ev.status = statuses[i] <= static_cast<uint8_t>(EventStatus::CANCELLED)
+                ? static_cast<EventStatus>(statuses[i]) : EventStatus::UPCOMING;
+            ev.totalFee = totalFees[i];
+            ev.themeCost = themeCosts[i];
+            ev.averageRating = averages[i];
+
+            ev.title = move(titles[i]);
+            ev.description = move(descriptions[i]);
+            if (packedDates) {
+                ev.date = CalendarDay::fromDays(days[i]);
+                ev.time = slots[i] < TIME_SLOT_COUNT ? static_cast<TimeSlot>(slots[i]) : TimeSlot::NONE;
+                if (version >= 4) {
+                    ev.legacyDate = move(dates[i]);
+                    ev.legacyTime = move(times[i]);
+                }
+            }
+            else {
+                ev.setDateText(dates[i]);
+                ev.setTimeText(times[i]);
+            }
+            ev.location = move(locations[i]);
+            ev.themeName = move(themeNames[i]);
+            ev.vendorName = move(vendorNames[i]);
+            ev.marketing = move(marketing[i]);
+
+            ev.attendees.assign(attendeeIds.begin() + attendeePos,
+                attendeeIds.begin() + attendeePos + attendeeCounts[i]);
+            attendeePos += attendeeCounts[i];
+
+            ev.ratings.resize(ratingCounts[i]);
+            for (Rating& r : ev.ratings) {
+                r.attendeeId = ratingAttendees[ratingPos];
+                r.rating = ratingValues[ratingPos];
+                r.comment = move(comments[ratingPos]);
+                r.complaint = move(complaints[ratingPos]);
+                ratingPos++;
+            }
+
+            if (hasStats) {
+                RatingStats& stats = ev.ratingStats;
+                stats.count = ratingCounts[i];
+                stats.sum = ratingSums[i];
+                stats.min = ratingMins[i];
+                stats.max = ratingMaxes[i];
+                for (int star = 0; star < RATING_STARS; star++) stats.histogram[star] = histograms[star][i];
+            }
+            else {
+                ev.ratingStats.rebuild(ev.ratings);
+            }
+        }
+
+        events = move(loaded);
+    }
+    catch (const exception& e) {
+        cerr << "Error: " << filename << " is not a valid event store: " << e.what() << endl;
+        return StoreLoad::INVALID;
+    }
+
+    return StoreLoad::OK;
+}
+
+bool convertEventsTextToBinary(const string& textFile, const string& binaryFile) {
+    ifstream probe(textFile);
+    if (!probe) {
+        cerr << "Error: " << textFile << " not found, nothing to convert." << endl;
+        return false;
+    }
+    probe.close();
+
+    vector<Event> legacy;
+    loadEventsFromFile(legacy, textFile);
+    if (!saveEventsToBinaryFile(legacy, binaryFile)) {
+        cerr << "Error: " << binaryFile << " was not written; nothing was converted." << endl;
+        return false;
+    }
+    cout << "Converted " << legacy.size() << " events from " << textFile
+        << " to " << binaryFile << "." << endl;
+    return true;
+}
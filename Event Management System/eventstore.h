@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "event.h"
+#include "eventrepository.h"
+
+using namespace std;
+
+// Binary columnar event store (events.bin).
+//
+// Layout (little-endian, host width types):
+//   header   : magic "EVTB", uint32 version, uint64 event count
+//   numeric  : one fixed-width column per field (id, organizerId, ...); from
+//              v3 the date (CalendarDay::days) and slot (TimeSlot) are here
+//   strings  : per column, uint32 length[count] followed by the packed bytes;
+//              before v3 the date and slot text sit after the description;
+//              from v4 the date and slot text that did not parse (usually
+//              empty) follow the marketing column
+//   attendees: uint32 count[events] followed by the packed int32 ids
+//   ratings  : uint32 count[events] followed by packed rating columns
+//   stats    : (v2+) rating sum/min/max and one column per star of the histogram
+//
+// The whole file is read with a single read() and decoded in place, so load
+// time is bounded by disk bandwidth rather than by text parsing.
+
+// Version 1 files (no stats columns) are still read; their stats are rebuilt on load.
+// Version 1-2 dates and slots are parsed from text; text that does not parse
+// is kept as Event::legacyDate/legacyTime.
+const uint32_t EVENT_STORE_VERSION = 4;
+
+// Returns false if the store could not be written.
+bool saveEventsToBinaryFile(const vector<Event>& events, const string& filename = "events.bin");
+bool saveEventsToBinaryFile(const EventRepository& events, const string& filename = "events.bin");
+
+enum class StoreLoad {
+    OK,
+    MISSING,        // no such file
+    INVALID         // unreadable, damaged or from a newer version; left untouched
+};
+
+StoreLoad loadEventsFromBinaryFile(vector<Event>& events, const string& filename = "events.bin");
+
+// One-shot migration of a legacy pipe-delimited events.dat into events.bin.
+bool convertEventsTextToBinary(const string& textFile = "events.dat", const string& binaryFile = "events.bin");
@@ -66,6 +66,19 @@ bool isValidEmail(const string& email) {
 }
 
 
+void printRatingSummary(const RatingStats& stats) {
+    cout << "Average Rating: " << fixed << setprecision(1) << stats.mean();
+    if (stats.count > 0) {
+        cout << " (" << stats.count << (stats.count == 1 ? " rating" : " ratings")
+            << ", lowest " << stats.min << ", highest " << stats.max << ")\n";
+        cout << " ";
+        for (int stars = RATING_STARS; stars >= 1; stars--) {
+            cout << " " << stars << "*: " << stats.starCount(stars);
+        }
+    }
+    cout << "\n";
+}
+
 void pauseScreen() {
     cout << "\nPress Enter to continue...";
     cin.ignore(numeric_limits<streamsize>::max(), '\n');
@@ -91,23 +104,13 @@ char getYesNoInput() {
 
 
 bool isValidDate(const string& date) {
-    if (date.length() != 10) return false;
-    if (date[4] != '-' || date[7] != '-') return false;
-
-    try {
-        int year = stoi(date.substr(0, 4));
-        int month = stoi(date.substr(5, 2));
-        int day = stoi(date.substr(8, 2));
-
-        if (year < 2025 || year > 2028) return false;
-        if (month < 1 || month > 12) return false;
-        if (day < 1 || day > 31) return false;
-    }
-    catch (...) {
-        return false;
-    }
+    return isValidDate(CalendarDay::parse(date));
+}
 
-    return true;
+bool isValidDate(CalendarDay date) {
+    static const CalendarDay FIRST = CalendarDay::fromCivil(2025, 1, 1);
+    static const CalendarDay LAST = CalendarDay::fromCivil(2028, 12, 31);
+    return !date.empty() && date >= FIRST && date <= LAST;
 }
 
 string getPasswordInput(const string& prompt) {
@@ -7,22 +7,26 @@
 #include <conio.h> 
 #include "user.h"
 #include "event.h"
+#include "eventrepository.h"
 
 using namespace std;
 
 extern vector<User> users;
-extern vector<Event> events;
+extern EventRepository events;
 
 void displayIntro();
 void clearScreen();
 bool isValidEmail(const string& email);
 int getIntInput(int min, int max, bool allowZeroExit = false);
 bool isValidDate(const string& date);
+// A real calendar day from 2025-01-01 to 2028-12-31
+bool isValidDate(CalendarDay date);
 bool isValidTime(const string& time);
 void debugPrintFileContents(const string& filename);
 void pauseScreen();
+void printRatingSummary(const RatingStats& stats);
 char getYesNoInput();
 string statusToString(EventStatus status);
-EventStatus stringToStatus(const string& str);
+EventStatus stringToStatus(string_view str);
 
 string getPasswordInput(const string& prompt = "Password: ");
\ No newline at end of file
@@ -0,0 +1,32 @@
+#include "internedstring.h"
+#include <mutex>
+#include <set>
+
+using namespace std;
+
+struct InternPool {
+    mutex lock;
+    // Set nodes never move, so the pointers handed out stay valid
+    set<string, less<>> strings;
+};
+
+// Built on first use, so interned globals in other files are safe to initialise
+static InternPool& internPool() {
+    static InternPool pool;
+    return pool;
+}
+
+const string* InternedString::intern(string_view text) {
+    if (text.empty()) return nullptr;
+
+    InternPool& pool = internPool();
+    lock_guard<mutex> guard(pool.lock);
+    auto it = pool.strings.find(text);
+    if (it == pool.strings.end()) it = pool.strings.emplace(text).first;
+    return &*it;
+}
+
+const string& InternedString::emptyText() {
+    static const string empty;
+    return empty;
+}
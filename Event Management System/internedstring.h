@@ -0,0 +1,49 @@
+#pragma once
+#include <ostream>
+#include <string>
+#include <string_view>
+
+using namespace std;
+
+// A string kept once in a process-wide pool; a copy is one pointer.
+//
+// Meant for low-cardinality fields that repeat across many records (venue,
+// theme, vendor, user role). Two interned strings are equal exactly when they
+// point at the same pool entry, so comparing them is a pointer compare.
+// Pool entries are never freed, so do not intern free text.
+//
+// Interning takes a lock; reading, copying and comparing do not.
+class InternedString {
+public:
+    InternedString() = default;     // ""
+    explicit InternedString(string_view text) : text_(intern(text)) {}
+
+    InternedString& operator=(string_view text) {
+        text_ = intern(text);
+        return *this;
+    }
+
+    const string& str() const { return text_ ? *text_ : emptyText(); }
+    operator const string&() const { return str(); }
+    bool empty() const { return text_ == nullptr; }
+
+    bool operator==(InternedString other) const { return text_ == other.text_; }
+    bool operator!=(InternedString other) const { return text_ != other.text_; }
+
+private:
+    // nullptr for ""
+    static const string* intern(string_view text);
+    static const string& emptyText();
+
+    const string* text_ = nullptr;
+};
+
+// Text compares, for values that are not interned
+inline bool operator==(InternedString a, string_view b) { return a.str() == b; }
+inline bool operator!=(InternedString a, string_view b) { return a.str() != b; }
+inline bool operator==(string_view a, InternedString b) { return a == b.str(); }
+inline bool operator!=(string_view a, InternedString b) { return a != b.str(); }
+
+inline ostream& operator<<(ostream& out, InternedString text) {
+    return out << text.str();
+}
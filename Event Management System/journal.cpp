@@ -0,0 +1,459 @@
+#include "journal.h"
+#include "eventstore.h"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+using namespace std;
+
+extern vector<User> users;
+extern EventRepository events;
+
+static const char* JOURNAL_FILE = "events.journal";
+static const char* JOURNAL_OLD_FILE = "events.journal.old";
+
+static ofstream journalOut;
+static uint64_t journalBytes = 0;
+static thread compactionThread;
+static atomic<bool> compactionRunning(false);
+static bool autoCompaction = true;
+static bool compactionDue = false;
+// Appends come from several threads in server mode
+static mutex journalMutex;
+
+static uint32_t fnv1a(const char* data, size_t size, uint32_t hash = 2166136261u) {
+    for (size_t i = 0; i < size; i++) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// ---------- record encoding ----------
+
+struct RecordWriter {
+    vector<char> buf;
+
+    void bytes(const void* data, size_t size) {
+        const char* p = static_cast<const char*>(data);
+        buf.insert(buf.end(), p, p + size);
+    }
+
+    template <typename T>
+    void value(T v) { bytes(&v, sizeof(T)); }
+
+    void str(const string& s) {
+        value<uint32_t>(static_cast<uint32_t>(s.size()));
+        bytes(s.data(), s.size());
+    }
+
+    void rating(const Rating& r) {
+        value<int32_t>(r.attendeeId);
+        value<double>(r.rating);
+        str(r.comment);
+        str(r.complaint);
+    }
+
+    void event(const Event& ev) {
+        value<int32_t>(ev.id);
+        str(ev.title);
+        str(ev.description);
+        str(ev.dateText());
+        str(ev.timeText());
+        str(ev.location);
+        value<int32_t>(ev.organizerId);
+        value<uint32_t>(static_cast<uint32_t>(ev.attendees.size()));
+        for (int id : ev.attendees) value<int32_t>(id);
+        value<int32_t>(ev.expectedParticipants);
+        value<double>(ev.totalFee);
+        value<double>(ev.themeCost);
+        str(ev.themeName);
+        str(ev.vendorName);
+        str(ev.marketing);
+        value<uint8_t>(static_cast<uint8_t>(ev.status));
+        value<uint32_t>(static_cast<uint32_t>(ev.ratings.size()));
+        for (const Rating& r : ev.ratings) rating(r);
+        value<double>(ev.averageRating);
+    }
+
+    void user(const User& u) {
+        value<int32_t>(u.id);
+        str(u.username);
+        str(u.password);
+        str(u.role);
+        str(u.name);
+        str(u.email);
+    }
+};
+
+struct RecordReader {
+    const char* cur;
+    const char* end;
+
+    void need(size_t size) const {
+        if (static_cast<size_t>(end - cur) < size) {
+            throw runtime_error("truncated record");
+        }
+    }
+
+    template <typename T>
+    T value() {
+        need(sizeof(T));
+        T v;
+        memcpy(&v, cur, sizeof(T));
+        cur += sizeof(T);
+        return v;
+    }
+
+    string str() {
+        uint32_t size = value<uint32_t>();
+        need(size);
+        string s(cur, size);
+        cur += size;
+        return s;
+    }
+
+    Rating rating() {
+        Rating r;
+        r.attendeeId = value<int32_t>();
+        r.rating = value<double>();
+        r.comment = str();
+        r.complaint = str();
+        return r;
+    }
+
+    Event event() {
+        Event ev;
+        ev.id = value<int32_t>();
+        ev.title = str();
+        ev.description = str();
+        ev.setDateText(str());
+        ev.setTimeText(str());
+        ev.location = str();
+        ev.organizerId = value<int32_t>();
+        uint32_t attendeeCount = value<uint32_t>();
+        need(static_cast<size_t>(attendeeCount) * sizeof(int32_t));
+        for (uint32_t i = 0; i < attendeeCount; i++) ev.attendees.insert(value<int32_t>());
+        ev.expectedParticipants = value<int32_t>();
+        ev.totalFee = value<double>();
+        ev.themeCost = value<double>();
+        ev.themeName = str();
+        ev.vendorName = str();
+        ev.marketing = str();
+        uint8_t status = value<uint8_t>();
+        ev.status = status <= static_cast<uint8_t>(EventStatus::CANCELLED)
+            ? static_cast<EventStatus>(status) : EventStatus::UPCOMING;
+        uint32_t ratingCount = value<uint32_t>();
+        for (uint32_t i = 0; i < ratingCount; i++) ev.ratings.push_back(rating());
+        ev.averageRating = value<double>();
+        ev.ratingStats.rebuild(ev.ratings);
+        return ev;
+    }
+
+    User user() {
+        User u;
+        u.id = value<int32_t>();
+        u.username = str();
+        u.password = str();
+        u.role = str();
+        u.name = str();
+        u.email = str();
+        return u;
+    }
+};
+
+// ---------- compaction ----------
+
+template <typename Events>
+static bool writeSnapshot(const vector<User>& userSnapshot, const Events& eventSnapshot) {
+    // The journal may only go once both files hold everything it records
+    return saveUsersToFile(userSnapshot) && saveEventsToBinaryFile(eventSnapshot);
+}
+
+static void startBackgroundCompaction() {
+    if (compactionRunning) return;
+    if (compactionThread.joinable()) compactionThread.join();
+
+    // A leftover old segment means the last snapshot failed; keep appending until it succeeds
+    journalOut.close();
+    if (ifstream(JOURNAL_OLD_FILE) || rename(JOURNAL_FILE, JOURNAL_OLD_FILE) != 0) {
+        return;
+    }
+    journalBytes = 0;
+
+    // The copy is taken here so the writer thread never touches the live containers
+    vector<User> userSnapshot = users;
+    vector<Event> eventSnapshot(events.begin(), events.end());
+
+    compactionRunning = true;
+    compactionThread = thread([userSnapshot = move(userSnapshot), eventSnapshot = move(eventSnapshot)]() {
+        if (writeSnapshot(userSnapshot, eventSnapshot)) {
+            remove(JOURNAL_OLD_FILE);
+        }
+        compactionRunning = false;
+    });
+}
+
+// ---------- appending ----------
+
+static void appendRecord(JournalOp op, const RecordWriter& payload) {
+    lock_guard<mutex> lock(journalMutex);
+    if (!journalOut.is_open()) {
+        journalOut.open(JOURNAL_FILE, ios::binary | ios::app);
+        if (!journalOut) {
+            cerr << "Error: Cannot open " << JOURNAL_FILE << " for writing!" << endl;
+            return;
+        }
+        journalOut.seekp(0, ios::end);
+        journalBytes = static_cast<uint64_t>(journalOut.tellp());
+    }
+
+    uint8_t opByte = static_cast<uint8_t>(op);
+    uint32_t length = static_cast<uint32_t>(payload.buf.size());
+    uint32_t checksum = fnv1a(payload.buf.data(), payload.buf.size(),
+        fnv1a(reinterpret_cast<const char*>(&opByte), 1));
+
+    journalOut.write(reinterpret_cast<const char*>(&length), sizeof(length));
+    journalOut.write(reinterpret_cast<const char*>(&opByte), 1);
+    journalOut.write(payload.buf.data(), static_cast<streamsize>(payload.buf.size()));
+    journalOut.write(reinterpret_cast<const char*>(&checksum), sizeof(checksum));
+    journalOut.flush();
+
+    if (!journalOut) {
+        cerr << "Error: Failed writing " << JOURNAL_FILE << endl;
+        journalOut.close();
+        return;
+    }
+
+    journalBytes += sizeof(length) + 1 + payload.buf.size() + sizeof(checksum);
+    if (journalBytes >= JOURNAL_COMPACT_BYTES) {
+        if (autoCompaction) startBackgroundCompaction();
+        else compactionDue = true;
+    }
+}
+
+void setJournalAutoCompaction(bool enabled) {
+    lock_guard<mutex> lock(journalMutex);
+    autoCompaction = enabled;
+}
+
+bool journalCompactionDue() {
+    lock_guard<mutex> lock(journalMutex);
+    return compactionDue;
+}
+
+void compactJournal() {
+    lock_guard<mutex> lock(journalMutex);
+    compactionDue = false;
+    startBackgroundCompaction();
+}
+
+void journalEventPut(const Event& ev) {
+    RecordWriter w;
+    w.event(ev);
+    appendRecord(JournalOp::EVENT_PUT, w);
+}
+
+void journalEventDelete(int eventId) {
+    RecordWriter w;
+    w.value<int32_t>(eventId);
+    appendRecord(JournalOp::EVENT_DELETE, w);
+}
+
+void journalAttendeeAdd(int eventId, int userId) {
+    RecordWriter w;
+    w.value<int32_t>(eventId);
+    w.value<int32_t>(userId);
+    appendRecord(JournalOp::ATTENDEE_ADD, w);
+}
+
+void journalAttendeeRemove(int eventId, int userId) {
+    RecordWriter w;
+    w.value<int32_t>(eventId);
+    w.value<int32_t>(userId);
+    appendRecord(JournalOp::ATTENDEE_REMOVE, w);
+}
+
+void journalStatusSet(int eventId, EventStatus status) {
+    RecordWriter w;
+    w.value<int32_t>(eventId);
+    w.value<uint8_t>(static_cast<uint8_t>(status));
+    appendRecord(JournalOp::STATUS_SET, w);
+}
+
+void journalMarketingSet(int eventId, const string& marketing) {
+    RecordWriter w;
+    w.value<int32_t>(eventId);
+    w.str(marketing);
+    appendRecord(JournalOp::MARKETING_SET, w);
+}
+
+void journalRatingPut(int eventId, const Rating& rating, double averageRating) {
+    RecordWriter w;
+    w.value<int32_t>(eventId);
+    w.rating(rating);
+    w.value<double>(averageRating);
+    appendRecord(JournalOp::RATING_PUT, w);
+}
+
+void journalUserPut(const User& user) {
+    RecordWriter w;
+    w.user(user);
+    appendRecord(JournalOp::USER_PUT, w);
+}
+
+void journalUserDelete(int userId) {
+    RecordWriter w;
+    w.value<int32_t>(userId);
+    appendRecord(JournalOp::USER_DELETE, w);
+}
+
+// ---------- replay ----------
+
+static void applyRecord(JournalOp op, RecordReader& in, vector<User>& users, EventRepository& events) {
+    switch (op) {
+    case JournalOp::EVENT_PUT:
+        events.put(in.event());
+        break;
+    case JournalOp::EVENT_DELETE:
+        events.remove(in.value<int32_t>());
+        break;
+    case JournalOp::ATTENDEE_ADD: {
+        int eventId = in.value<int32_t>();
+        int userId = in.value<int32_t>();
+        events.addAttendee(eventId, userId);
+        break;
+    }
+    case JournalOp::ATTENDEE_REMOVE: {
+        int eventId = in.value<int32_t>();
+        int userId = in.value<int32_t>();
+        events.removeAttendee(eventId, userId);
+        break;
+    }
+    case JournalOp::STATUS_SET: {
+        int eventId = in.value<int32_t>();
+        uint8_t status = in.value<uint8_t>();
+        if (status <= static_cast<uint8_t>(EventStatus::CANCELLED)) {
+            events.setStatus(eventId, static_cast<EventStatus>(status));
+        }
+        break;
+    }
+    case JournalOp::MARKETING_SET: {
+        int eventId = in.value<int32_t>();
+        events.setMarketing(eventId, in.str());
+        break;
+    }
+    case JournalOp::RATING_PUT: {
+        int eventId = in.value<int32_t>();
+        Rating rating = in.rating();
+        in.value<double>(); // stored average; the repository recomputes it
+        events.putRating(eventId, rating);
+        break;
+    }
+    case JournalOp::USER_PUT: {
+        User user = in.user();
+        bool updated = false;
+        for (User& u : users) {
+            if (u.id == user.id) {
+                u = user;
+                updated = true;
+                break;
+            }
+        }
+        if (!updated) users.push_back(user);
+        break;
+    }
+    case JournalOp::USER_DELETE: {
+        int userId = in.value<int32_t>();
+        // Same cascade as the admin "Delete User" screen
+        events.removeUser(userId);
+        users.erase(remove_if(users.begin(), users.end(),
+            [userId](const User& u) { return u.id == userId; }), users.end());
+        break;
+    }
+    default:
+        throw runtime_error("unknown op " + to_string(static_cast<int>(op)));
+    }
+}
+
+static size_t replayFile(const char* filename, vector<User>& users, EventRepository& events, bool& damaged) {
+    ifstream inFile(filename, ios::binary | ios::ate);
+    if (!inFile) return 0;
+
+    streamsize size = inFile.tellg();
+    inFile.seekg(0);
+    vector<char> buf(static_cast<size_t>(size));
+    if (size > 0 && !inFile.read(buf.data(), size)) {
+        cerr << "Warning: Cannot read " << filename << endl;
+        damaged = true;
+        return 0;
+    }
+
+    size_t applied = 0;
+    RecordReader in{ buf.data(), buf.data() + buf.size() };
+    while (in.cur < in.end) {
+        const char* recordStart = in.cur;
+        try {
+            uint32_t length = in.value<uint32_t>();
+            uint8_t opByte = in.value<uint8_t>();
+            in.need(static_cast<size_t>(length) + sizeof(uint32_t));
+
+            uint32_t expected = fnv1a(in.cur, length, fnv1a(reinterpret_cast<const char*>(&opByte), 1));
+            uint32_t stored;
+            memcpy(&stored, in.cur + length, sizeof(stored));
+            if (stored != expected) {
+                throw runtime_error("checksum mismatch");
+            }
+
+            RecordReader payload{ in.cur, in.cur + length };
+            applyRecord(static_cast<JournalOp>(opByte), payload, users, events);
+            in.cur += length + sizeof(uint32_t);
+            applied++;
+        }
+        catch (const exception& e) {
+            cerr << "Warning: " << filename << " damaged at offset " << (recordStart - buf.data())
+                << " (" << e.what() << "); ignoring the rest." << endl;
+            damaged = true;
+            break;
+        }
+    }
+    return applied;
+}
+
+size_t replayJournal(vector<User>& users, EventRepository& events, bool checkpoint) {
+    bool damaged = false;
+    bool hadOldSegment = static_cast<bool>(ifstream(JOURNAL_OLD_FILE));
+
+    size_t applied = replayFile(JOURNAL_OLD_FILE, users, events, damaged);
+    applied += replayFile(JOURNAL_FILE, users, events, damaged);
+
+    if (applied > 0) {
+        cout << "Replayed " << applied << " journal records." << endl;
+    }
+
+    // Fold an interrupted compaction or a torn tail into a clean snapshot right away
+    if (checkpoint && (hadOldSegment || damaged)) {
+        checkpointJournal(users, events);
+    }
+    return applied;
+}
+
+bool checkpointJournal(const vector<User>& users, const EventRepository& events) {
+    lock_guard<mutex> lock(journalMutex);
+    if (compactionThread.joinable()) compactionThread.join();
+    journalOut.close();
+
+    // On failure the journal stays, so the next start still replays it
+    bool saved = writeSnapshot(users, events);
+    if (saved) {
+        remove(JOURNAL_FILE);
+        remove(JOURNAL_OLD_FILE);
+        journalBytes = 0;
+    }
+    return saved;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "user.h"
+#include "event.h"
+#include "eventrepository.h"
+
+using namespace std;
+
+// Append-only write-ahead journal (events.journal).
+//
+// Each mutation appends one self-contained record instead of rewriting
+// users.dat/events.bin, so the cost of a sign-up no longer grows with the
+// dataset. On startup the journal is replayed on top of the last snapshot.
+// Once the journal passes JOURNAL_COMPACT_BYTES, a fresh snapshot is written
+// on a background thread and the journal starts over.
+//
+// Record layout: uint32 payload length, uint8 op, payload, uint32 FNV-1a
+// checksum of op + payload. Replay stops at the first torn or corrupt record.
+// Every op is idempotent, so replaying a record twice is harmless.
+
+enum class JournalOp : uint8_t {
+    EVENT_PUT = 1,
+    EVENT_DELETE,
+    ATTENDEE_ADD,
+    ATTENDEE_REMOVE,
+    STATUS_SET,
+    MARKETING_SET,
+    RATING_PUT,
+    USER_PUT,
+    USER_DELETE
+};
+
+const uint64_t JOURNAL_COMPACT_BYTES = 4 * 1024 * 1024;
+
+void journalEventPut(const Event& ev);
+void journalEventDelete(int eventId);
+void journalAttendeeAdd(int eventId, int userId);
+void journalAttendeeRemove(int eventId, int userId);
+void journalStatusSet(int eventId, EventStatus status);
+void journalMarketingSet(int eventId, const string& marketing);
+void journalRatingPut(int eventId, const Rating& rating, double averageRating);
+void journalUserPut(const User& user);
+void journalUserDelete(int userId);
+
+// Applies any journal records left since the last snapshot. Returns the number of records applied.
+// An interrupted compaction or a damaged tail is folded into a fresh snapshot
+// unless `checkpoint` is false (read-only callers).
+size_t replayJournal(vector<User>& users, EventRepository& events, bool checkpoint = true);
+
+// Journal appends are serialized internally. Compaction copies the live
+// users/events, so a multi-threaded caller turns automatic compaction off
+// and calls compactJournal() itself once journalCompactionDue() says so,
+// at a point where nothing else is touching the data.
+void setJournalAutoCompaction(bool enabled);
+bool journalCompactionDue();
+void compactJournal();
+
+// Writes a full snapshot synchronously and truncates the journal (used at shutdown).
+// Returns false, keeping the journal, if either users.dat or events.bin failed.
+bool checkpointJournal(const vector<User>& users, const EventRepository& events);
@@ -0,0 +1,66 @@
+#include "leaderboard.h"
+
+using namespace std;
+
+// Every ordering ends on id, which is unique, so no two entries compare equal
+
+bool Leaderboard::ByAttendees::operator()(const Entry& a, const Entry& b) const {
+    if (a.attendees != b.attendees) return a.attendees > b.attendees;
+    if (a.rating != b.rating) return a.rating > b.rating;
+    return a.id > b.id;
+}
+
+bool Leaderboard::ByRating::operator()(const Entry& a, const Entry& b) const {
+    if (a.rating != b.rating) return a.rating > b.rating;
+    if (a.attendees != b.attendees) return a.attendees > b.attendees;
+    return a.id > b.id;
+}
+
+bool Leaderboard::ByRecency::operator()(const Entry& a, const Entry& b) const {
+    return a.id > b.id;
+}
+
+Leaderboard::Entry Leaderboard::entryFor(const Event& ev) {
+    return Entry{ ev.attendees.size(), ev.averageRating, ev.id, &ev };
+}
+
+void Leaderboard::add(const Event& ev) {
+    lock_guard<mutex> lock(mutex_);
+    Entry entry = entryFor(ev);
+    byAttendees_.insert(entry);
+    byRating_.insert(entry);
+    byRecency_.insert(entry);
+}
+
+void Leaderboard::remove(const Event& ev) {
+    lock_guard<mutex> lock(mutex_);
+    Entry entry = entryFor(ev);
+    byAttendees_.erase(entry);
+    byRating_.erase(entry);
+    byRecency_.erase(entry);
+}
+
+void Leaderboard::clear() {
+    lock_guard<mutex> lock(mutex_);
+    byAttendees_.clear();
+    byRating_.clear();
+    byRecency_.clear();
+}
+
+template <typename Ranked>
+static vector<const Event*> firstK(const Ranked& ranked, size_t k) {
+    vector<const Event*> result;
+    for (auto it = ranked.begin(); it != ranked.end() && result.size() < k; ++it) {
+        result.push_back(it->event);
+    }
+    return result;
+}
+
+vector<const Event*> Leaderboard::top(size_t k, LeaderboardRank rank) const {
+    lock_guard<mutex> lock(mutex_);
+    switch (rank) {
+    case LeaderboardRank::RATING: return firstK(byRating_, k);
+    case LeaderboardRank::RECENT: return firstK(byRecency_, k);
+    default: return firstK(byAttendees_, k);
+    }
+}
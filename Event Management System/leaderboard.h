@@ -0,0 +1,49 @@
+#pragma once
+#include <mutex>
+#include <set>
+#include <vector>
+#include "event.h"
+
+using namespace std;
+
+enum class LeaderboardRank {
+    ATTENDEES,      // most attendees, then best rated, then newest
+    RATING,         // best rated, then most attendees, then newest
+    RECENT          // newest (highest id) first
+};
+
+// Events kept in ranked order for the "top event" banner.
+//
+// Each ranking is an ordered set, so a registration or rating change is an
+// O(log n) remove + re-insert and the top K are the first K entries. The
+// repository calls remove() before changing a ranked field (attendees,
+// averageRating) and add() afterwards.
+//
+// The rankings are shared by every event, so they carry their own lock:
+// the server updates different events in parallel and only meets here.
+class Leaderboard {
+public:
+    void add(const Event& ev);
+    void remove(const Event& ev);
+    void clear();
+
+    vector<const Event*> top(size_t k, LeaderboardRank rank = LeaderboardRank::ATTENDEES) const;
+
+private:
+    struct Entry {
+        size_t attendees;
+        double rating;
+        int id;
+        const Event* event;
+    };
+    struct ByAttendees { bool operator()(const Entry& a, const Entry& b) const; };
+    struct ByRating { bool operator()(const Entry& a, const Entry& b) const; };
+    struct ByRecency { bool operator()(const Entry& a, const Entry& b) const; };
+
+    static Entry entryFor(const Event& ev);
+
+    set<Entry, ByAttendees> byAttendees_;
+    set<Entry, ByRating> byRating_;
+    set<Entry, ByRecency> byRecency_;
+    mutable mutex mutex_;
+};
@@ -2,7 +2,17 @@
 #include <vector>
 #include "user.h"
 #include "event.h"
+#include "eventrepository.h"
+#include "eventservice.h"
+#include "eventstore.h"
+#include "journal.h"
+#include "metrics.h"
+#include "batch.h"
+#include "benchmark.h"
 #include "helpers.h"
+#include "selftest.h"
+#include "server.h"
+#include "workload.h"
 #include "admin.h"
 #include "organizer.h"
 #include "attendee.h"
@@ -13,25 +23,90 @@ using namespace std;
 
 // Global containers
 vector<User> users;
-vector<Event> events;
+EventRepository events;
 
 void login();
 void registerUser();
 void mainMenu();
+// False when the data on disk must not be overwritten
+// `readOnly` loads without writing anything back (no events.bin import,
+// default admin or journal checkpoint)
+bool loadData(bool readOnly = false);
+void saveData();
+
+int main(int argc, char* argv[]) {
+    // One-shot migration: assignment2 --convert-events [events.dat] [events.bin]
+    if (argc > 1 && string(argv[1]) == "--convert-events") {
+        string textFile = argc > 2 ? argv[2] : "events.dat";
+        string binaryFile = argc > 3 ? argv[3] : "events.bin";
+        return convertEventsTextToBinary(textFile, binaryFile) ? 0 : 1;
+    }
 
-int main() {
-    cout << "Starting Event Management System..." << endl;
+    // Parser micro-benchmark: assignment2 --bench-parser [bench_events.dat] [rounds]
+    if (argc > 1 && string(argv[1]) == "--bench-parser") {
+        string file = argc > 2 ? argv[2] : "bench_events.dat";
+        int rounds = argc > 3 ? atoi(argv[3]) : 5;
+        return runParserBenchmark(file, rounds > 0 ? rounds : 1);
+    }
 
-    try {
-        loadUsersFromFile(users);
-        loadEventsFromFile(events);
-        cout << "Data loaded successfully." << endl;
+    // Hot-path suite: assignment2 --bench [events] [rounds] [file prefix]
+    if (argc > 1 && string(argv[1]) == "--bench") {
+        int eventCount = argc > 2 ? atoi(argv[2]) : 10000;
+        int rounds = argc > 3 ? atoi(argv[3]) : 3;
+        return runBenchmarkSuite(eventCount > 0 ? eventCount : 10000, rounds > 0 ? rounds : 1, argc > 4 ? argv[4] : "bench_suite_");
     }
-    catch (const exception& e) {
-        cerr << "Error loading data: " << e.what() << endl;
-        cout << "Starting with minimal default data..." << endl;
+
+    // Seat reservation stress check: assignment2 --stress-seats [threads] [capacity]
+    if (argc > 1 && string(argv[1]) == "--stress-seats") {
+        int threads = argc > 2 ? atoi(argv[2]) : 16;
+        int capacity = argc > 3 ? atoi(argv[3]) : 100;
+        return runSeatStress(threads > 0 ? threads : 16, capacity > 0 ? capacity : 100);
+    }
+
+    // Built-in regression checks: assignment2 --self-test
+    if (argc > 1 && string(argv[1]) == "--self-test") {
+        return runSelfTest() == 0 ? 0 : 1;
+    }
+
+    // Dataset generator: assignment2 --generate [events] [seed] [file prefix]
+    if (argc > 1 && string(argv[1]) == "--generate") {
+        WorkloadOptions options;
+        if (argc > 2 && atoi(argv[2]) > 0) options.events = atoi(argv[2]);
+        if (argc > 3) options.seed = static_cast<uint32_t>(strtoul(argv[3], nullptr, 10));
+        return runWorkloadGenerator(options, argc > 4 ? argv[4] : "workload_");
+    }
+
+    // Headless commands: assignment2 --batch [commands.txt]   (stdin if omitted)
+    if (argc > 1 && string(argv[1]) == "--batch") {
+        if (!loadData()) return 1;
+        int failed = runBatchFile(argc > 2 ? argv[2] : "-");
+        saveData();
+        return failed == 0 ? 0 : 1;
     }
 
+    // Shared booking desk: assignment2 --serve [port]
+    if (argc > 1 && string(argv[1]) == "--serve") {
+        int port = argc > 2 ? atoi(argv[2]) : DEFAULT_SERVER_PORT;
+        if (!loadData()) return 1;
+        int status = runServer(port > 0 ? port : DEFAULT_SERVER_PORT);
+        saveData();
+        return status;
+    }
+
+    // Dashboard counters snapshot: assignment2 --metrics [file]   (default metrics.txt, stdout for "-")
+    if (argc > 1 && string(argv[1]) == "--metrics") {
+        // An export only reads: load messages go to stderr so "-" prints just
+        // the counters, and nothing is written back to disk
+        streambuf* out = cout.rdbuf(cerr.rdbuf());
+        bool loaded = loadData(true);
+        cout.rdbuf(out);
+        if (!loaded) return 1;
+        return writeMetrics(events, argc > 2 ? argv[2] : "metrics.txt");
+    }
+
+    cout << "Starting Event Management System..." << endl;
+    if (!loadData()) return 1;
+
     displayIntro();
 
     try {
@@ -41,18 +116,51 @@ int main() {
         cerr << "Runtime error: " << e.what() << endl;
     }
 
-    // Save data with error checking
+    saveData();
+
+    cout << "\nThank you for using the Event Management System. Goodbye!\n";
+    return 0;
+}
+
+bool loadData(bool readOnly) {
     try {
-        saveUsersToFile(users);
-        saveEventsToFile(events);
-        cout << "Data saved successfully." << endl;
+        loadUsersFromFile(users, "users.dat", !readOnly);
+        vector<Event> loaded;
+        StoreLoad store = loadEventsFromBinaryFile(loaded);
+        if (store == StoreLoad::INVALID) {
+            // Importing events.dat here would overwrite the only copy of newer data
+            cerr << "Error: events.bin was left untouched; restore or remove it and start again." << endl;
+            return false;
+        }
+        if (store == StoreLoad::MISSING) {
+            // First run after upgrade: import the legacy text file once
+            loadEventsFromFile(loaded);
+            if (!readOnly) saveEventsToBinaryFile(loaded);
+        }
+        events.load(move(loaded));
+        replayJournal(users, events, !readOnly);
+        rebuildUserIndex();
+        cout << "Data loaded successfully." << endl;
     }
     catch (const exception& e) {
-        cerr << "Error saving data: " << e.what() << endl;
+        cerr << "Error loading data: " << e.what() << endl;
+        cout << "Starting with minimal default data..." << endl;
     }
+    return true;
+}
 
-    cout << "\nThank you for using the Event Management System. Goodbye!\n";
-    return 0;
+void saveData() {
+    try {
+        if (checkpointJournal(users, events)) {
+            cout << "Data saved successfully." << endl;
+        }
+        else {
+            cerr << "Error: Data was not saved; changes are kept in the journal until the next successful save." << endl;
+        }
+    }
+    catch (const exception& e) {
+        cerr << "Error saving data: " << e.what() << endl;
+    }
 }
 
 void mainMenu() {
@@ -113,29 +221,25 @@ void login() {
     cin >> username;
     password = getPasswordInput();
 
-    bool found = false;
-    for (User& user : users) {
-        if (user.username == username && user.password == password) {
-            found = true;
-            cout << "\nLogin successful! Welcome, " << user.name << "!\n";
-            pauseScreen();
-            clearScreen();
+    User* account = findUserByUsername(username);
+    if (account && account->password == password) {
+        // Work on a copy: the menus may add or delete users, which moves vector storage
+        User user = *account;
+        cout << "\nLogin successful! Welcome, " << user.name << "!\n";
+        pauseScreen();
+        clearScreen();
 
-            if (user.role == "admin") {
-                adminMenu(user);
-            }
-            else if (user.role == "organizer") {
-                organizerMenu(user);
-            }
-            else if (user.role == "attendee") {
-                attendeeMenu(user);
-            }
-            break;
+        if (user.role == ROLE_ADMIN) {
+            adminMenu(user);
+        }
+        else if (user.role == ROLE_ORGANIZER) {
+            organizerMenu(user);
+        }
+        else if (user.role == ROLE_ATTENDEE) {
+            attendeeMenu(user);
         }
     }
-
-
-    if (!found) {
+    else {
         cout << "\nInvalid username or password. Please try again.\n";
         pauseScreen();
         clearScreen();
@@ -150,7 +254,6 @@ void registerUser() {
     cout << "Enter 0 at any time to cancel registration\n\n";
 
     User newUser;
-    newUser.id = generateUserId();
 
     cout << "Enter username: ";
     cin >> newUser.username;
@@ -162,13 +265,11 @@ void registerUser() {
         return;
     }
 
-    for (const User& user : users) {
-        if (user.username == newUser.username) {
-            cout << "Username already exists. Please choose another.\n";
-            pauseScreen();
-            clearScreen();
-            return;
-        }
+    if (findUserByUsername(newUser.username)) {
+        cout << "Username already exists. Please choose another.\n";
+        pauseScreen();
+        clearScreen();
+        return;
     }
 
     newUser.password = getPasswordInput("Enter password: ");
@@ -237,12 +338,15 @@ void registerUser() {
         return;
     }
 
-    newUser.role = (roleChoice == 1) ? "organizer" : "attendee";
+    newUser.role = (roleChoice == 1) ? ROLE_ORGANIZER : ROLE_ATTENDEE;
 
-    users.push_back(newUser);
-    saveUsersToFile(users);
-
-    cout << "\nRegistration successful! You can now login with your credentials.\n";
+    ServiceResult result = EventService(events).registerUser(newUser);
+    if (result.ok()) {
+        cout << "\nRegistration successful! You can now login with your credentials.\n";
+    }
+    else {
+        cout << "\nRegistration failed: " << result.message << ".\n";
+    }
     pauseScreen();
     clearScreen();
 }
\ No newline at end of file
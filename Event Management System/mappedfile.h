@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+// Read-only memory mapping of a whole file.
+//
+// The loaders parse straight out of the mapping as string_views, so a field
+// is only copied once: into the string that finally owns it.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Returns false if the file does not exist or cannot be mapped
+    bool open(const string& path);
+    void close();
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+    string_view view() const { return string_view(data_, size_); }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    void* file_ = nullptr;
+    void* mapping_ = nullptr;
+#endif
+};
+
+// Pops the next line off `rest` (without its "\n" or "\r\n"). Returns false at the end.
+bool nextLine(string_view& rest, string_view& line);
+
+// Renames `from` over `to` in one step, so `to` is always either the old or
+// the new file, never missing or half written. False if it could not.
+bool replaceFile(const string& from, const string& to);
+
+// Splits like repeated getline(ss, token, delim): a trailing empty field is dropped.
+// Any character in `delims` ends a field. `fields` is cleared but keeps its capacity.
+void splitFields(string_view line, string_view delims, vector<string_view>& fields);
@@ -2,22 +2,25 @@
 #include <iostream>
 #include <algorithm>
 #include <string>
+#include "eventservice.h"
 
 using namespace std;
 
-void displayTopEvent(const vector<Event>& events) {
+void displayTopEvent(const EventRepository& events) {
     if (!events.empty()) {
-        // Find the event with the most attendees
-        auto topEvent = max_element(events.begin(), events.end(),
-            [](const Event& a, const Event& b) {
-                return a.attendees.size() < b.attendees.size();
-            });
+        // Rotate through the leaderboard, one event per render
+        static size_t rotation = 0;
+        vector<const Event*> top = events.leaderboard().top(TOP_EVENT_BANNER_SIZE);
+        size_t rank = rotation++ % top.size();
+        const Event* topEvent = top[rank];
 
         string title = topEvent->title;
         size_t count = topEvent->attendees.size();
 
         // Create a properly formatted display
-        string content = "Today's Top Event: " + title + " (Attendees: " + to_string(count) + ")";
+        string content = "Today's Top Event";
+        if (top.size() > 1) content += " #" + to_string(rank + 1) + " of " + to_string(top.size());
+        content += ": " + title + " (Attendees: " + to_string(count) + ")";
 
         // Calculate border length based on content
         size_t borderLength = content.size() + 4; // +4 for spaces and border chars
@@ -42,18 +45,12 @@ void displayTopEvent(const vector<Event>& events) {
     }
 }
 
-void createAdvertisement(User& organizer, vector<Event>& events) {
+void createAdvertisement(User& organizer, EventRepository& events) {
     cout << "===== CREATE / UPDATE ADVERTISEMENT =====\n\n";
 
-    bool hasEvents = false;
-    for (const Event& event : events) {
-        if (event.organizerId == organizer.id) {
-            hasEvents = true;
-            break;
-        }
-    }
+    vector<const Event*> myEvents = events.byOrganizer(organizer.id);
 
-    if (!hasEvents) {
+    if (myEvents.empty()) {
         cout << "You haven't created any events yet.\n";
         cout << "\nPress Enter to continue...";
         cin.ignore(numeric_limits<streamsize>::max(), '\n');
@@ -63,12 +60,10 @@ void createAdvertisement(User& organizer, vector<Event>& events) {
 
     cout << "Your Events:\n";
     cout << string(60, '-') << "\n";
-    for (const Event& event : events) {
-        if (event.organizerId == organizer.id) {
-            cout << "ID: " << event.id << " | " << event.title << "\n";
-            cout << "Current Advertisement: " << (event.marketing.empty() ? "[None]" : event.marketing) << "\n";
-            cout << string(60, '-') << "\n";
-        }
+    for (const Event* event : myEvents) {
+        cout << "ID: " << event->id << " | " << event->title << "\n";
+        cout << "Current Advertisement: " << (event->marketing.empty() ? "[None]" : event->marketing) << "\n";
+        cout << string(60, '-') << "\n";
     }
 
     int eventId;
@@ -81,33 +76,26 @@ void createAdvertisement(User& organizer, vector<Event>& events) {
         return;
     }
 
-    bool found = false;
-    for (Event& event : events) {
-        if (event.id == eventId && event.organizerId == organizer.id) {
-            cout << "\nEvent: " << event.title << "\n";
-            cout << "Current advertisement: " << (event.marketing.empty() ? "[None]" : event.marketing) << "\n";
-            cout << "\nEnter new advertisement text (or leave blank to remove): ";
-
-            string newAd;
-            getline(cin, newAd);
-
-            event.marketing = newAd;
-
-            if (newAd.empty()) {
-                cout << "\nAdvertisement removed for event: " << event.title << endl;
-            }
-            else {
-                cout << "\nAdvertisement updated for event: " << event.title << endl;
-                cout << "New advertisement: " << newAd << endl;
-            }
-
-            saveEventsToFile(events);
-            found = true;
-            break;
+    const Event* event = events.find(eventId);
+    if (event && event->organizerId == organizer.id) {
+        cout << "\nEvent: " << event->title << "\n";
+        cout << "Current advertisement: " << (event->marketing.empty() ? "[None]" : event->marketing) << "\n";
+        cout << "\nEnter new advertisement text (or leave blank to remove): ";
+
+        string newAd;
+        getline(cin, newAd);
+
+        EventService(events).setMarketing(eventId, newAd, organizer.id);
+
+        if (newAd.empty()) {
+            cout << "\nAdvertisement removed for event: " << event->title << endl;
+        }
+        else {
+            cout << "\nAdvertisement updated for event: " << event->title << endl;
+            cout << "New advertisement: " << newAd << endl;
         }
     }
-
-    if (!found) {
+    else {
         cout << "\nInvalid event ID or you are not the organizer of this event.\n";
     }
 
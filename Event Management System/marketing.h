@@ -3,13 +3,16 @@
 
 #include <vector>
 #include "event.h"
+#include "eventrepository.h"
 #include "user.h"    
 
 using namespace std;  
-// Show the current top event
-void displayTopEvent(const std::vector<Event>& events);
+const size_t TOP_EVENT_BANNER_SIZE = 3;
+
+// Show one of the top events; each call rotates to the next
+void displayTopEvent(const EventRepository& events);
 
 // Create advertisement for an event
-void createAdvertisement(User& organizer, std::vector<Event>& events);
+void createAdvertisement(User& organizer, EventRepository& events);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,51 @@
+#include "metrics.h"
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include "user.h"
+
+using namespace std;
+
+extern vector<User> users;
+
+static string metric(const string& name, const string& label, size_t value) {
+    return label.empty() ? name + ' ' + to_string(value) : name + '{' + label + "} " + to_string(value);
+}
+
+vector<string> metricsSnapshot(const EventRepository& events) {
+    UserCounts roles = userCountsByRole();
+    CatalogueStats stats = events.stats();
+
+    vector<string> lines;
+    lines.push_back(metric("ems_users_total", "", users.size()));
+    lines.push_back(metric("ems_users", "role=\"admin\"", roles.admins));
+    lines.push_back(metric("ems_users", "role=\"organizer\"", roles.organizers));
+    lines.push_back(metric("ems_users", "role=\"attendee\"", roles.attendees));
+    lines.push_back(metric("ems_events_total", "", stats.events));
+    for (int i = 0; i < EVENT_STATUS_COUNT; i++) {
+        string label = "status=\"" + statusToString(static_cast<EventStatus>(i)) + "\"";
+        lines.push_back(metric("ems_events", label, stats.byStatus[i]));
+    }
+    lines.push_back(metric("ems_registrations_total", "", stats.attendees));
+    ostringstream revenue;
+    revenue << "ems_revenue_rm " << fixed << setprecision(2) << stats.revenue;
+    lines.push_back(revenue.str());
+    return lines;
+}
+
+int writeMetrics(const EventRepository& events, const string& filename) {
+    vector<string> lines = metricsSnapshot(events);
+    if (filename == "-") {
+        for (const string& line : lines) cout << line << '\n';
+        return 0;
+    }
+
+    ofstream outFile(filename, ios::trunc);
+    if (!outFile) {
+        cerr << "Error: Cannot open " << filename << " for writing!" << endl;
+        return 1;
+    }
+    for (const string& line : lines) outFile << line << '\n';
+    return 0;
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "eventrepository.h"
+
+using namespace std;
+
+// The dashboard counters as "name{label} value" lines (Prometheus text
+// format), e.g. ems_events{status="UPCOMING"} 12. Reads counters only, so it
+// costs the same for ten events or a million.
+vector<string> metricsSnapshot(const EventRepository& events);
+
+// assignment2 --metrics [file]   (metrics.txt when no file is given, stdout for "-")
+int writeMetrics(const EventRepository& events, const string& filename);
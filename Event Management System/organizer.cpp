@@ -1,6 +1,7 @@
 ﻿#include "organizer.h"
 #include "theme.h"
 #include "event.h"
+#include "eventservice.h"
 #include "payment.h"
 #include "helpers.h"
 #include "marketing.h"
@@ -37,13 +38,12 @@ void organizerMenu(User& organizer) {
         choice = getIntInput(1, 9);
         clearScreen();
 
-        extern vector<Event> events;
-        extern vector<User> users;
+        extern EventRepository events;
 
         switch (choice) {
         case 1: {
+            EventService service(events);
             Event newEvent;
-            newEvent.id = generateEventId(events);
             newEvent.organizerId = organizer.id;
 
             cout << "\n===== CREATE NEW EVENT =====\n";
@@ -64,20 +64,30 @@ void organizerMenu(User& organizer) {
                 break;
             }
 
+            string dateInput;
             do {
                 cout << "Enter date (YYYY-MM-DD)(2025-01-01 To 2028-12-31): ";
-                getline(cin, newEvent.date);
-                if (newEvent.date == "0") {
+                getline(cin, dateInput);
+                if (dateInput == "0") {
                     cout << "Event creation cancelled.\n";
                     pauseScreen();
                     break;
                 }
-                if (!isValidDate(newEvent.date)) {
+                if (!isValidDate(dateInput)) {
                     cout << "Invalid date format. Try again.(2025-01-01 To 2028-12-31)\n";
                 }
-            } while (!isValidDate(newEvent.date) && newEvent.date != "0");
+            } while (!isValidDate(dateInput) && dateInput != "0");
 
-            if (newEvent.date == "0") break;
+            if (dateInput == "0") break;
+            newEvent.date = CalendarDay::parse(dateInput);
+
+            vector<const Event*> booked = events.schedule().bookingsOn(newEvent.date);
+            if (!booked.empty()) {
+                cout << "\nAlready booked on " << newEvent.date << ":\n";
+                for (const Event* ev : booked) {
+                    cout << "  " << ev->location << " - " << ev->timeText() << endl;
+                }
+            }
 
             cout << "\nSelect time slot:\n";
             for (int i = 0; i < Event::slotOptions.size(); i++)
@@ -89,7 +99,7 @@ void organizerMenu(User& organizer) {
                 pauseScreen();
                 break;
             }
-            newEvent.time = Event::slotOptions[slotChoice - 1];
+            newEvent.time = static_cast<TimeSlot>(slotChoice - 1);
 
             cout << "\nSelect location:\n";
             cout << "1. 1st Floor Banquet Hall (RM50)\n";
@@ -103,31 +113,18 @@ void organizerMenu(User& organizer) {
                 break;
             }
 
-            int venueCost = 0;
-            if (locChoice == 1) {
-                newEvent.location = "1st Floor Banquet Hall";
-                venueCost = 50;
-            }
-            else if (locChoice == 2) {
-                newEvent.location = "2nd Floor Banquet Hall";
-                venueCost = 75;
-            }
-            else {
-                newEvent.location = "3rd Floor Banquet Hall";
-                venueCost = 100;
-            }
+            newEvent.location = HALLS[locChoice - 1].name;
 
-            bool conflict = false;
-            for (const auto& ev : events) {
-                if (ev.date == newEvent.date &&
-                    ev.time == newEvent.time &&
-                    ev.location == newEvent.location) {
-                    conflict = true;
-                    break;
-                }
-            }
-            if (conflict) {
+            if (!events.schedule().isFree(newEvent.location, newEvent.date, newEvent.time)) {
                 cout << "This slot and location are already taken. Event not created.\n";
+
+                vector<ScheduleKey> freeSlots = events.schedule().freeSlots(newEvent.location, newEvent.date, 30);
+                if (!freeSlots.empty()) {
+                    cout << "\nNext free slots at " << newEvent.location << ":\n";
+                    for (size_t i = 0; i < freeSlots.size() && i < 5; i++) {
+                        cout << "  " << freeSlots[i].date << " " << freeSlots[i].time << endl;
+                    }
+                }
                 pauseScreen();
                 break;
             }
@@ -162,13 +159,13 @@ void organizerMenu(User& organizer) {
             }
 
             double themeCost = 0;
-            string themeName, vendorName;
+            InternedString themeName, vendorName;
 
             if (themeChoice == 'y' || themeChoice == 'Y') {
                 themeCost = themeMenu(themeName, vendorName);
                 // You might want to add cancellation support in themeMenu too
-                newEvent.themeName = themeName.empty() ? "None" : themeName;
-                newEvent.vendorName = vendorName.empty() ? "None" : vendorName;
+                newEvent.themeName = themeName.empty() ? InternedString("None") : themeName;
+                newEvent.vendorName = vendorName.empty() ? InternedString("None") : vendorName;
             }
             else {
                 newEvent.themeName = "None";
@@ -176,13 +173,19 @@ void organizerMenu(User& organizer) {
             }
             newEvent.themeCost = themeCost;
 
-            newEvent.totalFee = calculateTotalFee(venueCost, newEvent.expectedParticipants, themeCost);
-
+            ServiceResult quote = service.quoteEvent(newEvent);
+            if (!quote.ok()) {
+                cout << "\nEvent not created: " << quote.message << ".\n";
+            }
             // Only save if payment is successful
-            if (ProcessPayment(newEvent.totalFee)) {
-                events.push_back(newEvent);
-                saveEventsToFile(events);
-                cout << "\nBooking completed successfully!\n";
+            else if (ProcessPayment(newEvent.totalFee)) {
+                ServiceResult result = service.createEvent(newEvent);
+                if (result.ok()) {
+                    cout << "\nBooking completed successfully!\n";
+                }
+                else {
+                    cout << "\nEvent not created: " << result.message << ".\n";
+                }
             }
             else {
                 cout << "\nPayment failed or cancelled. Event was not created.\n";
@@ -196,13 +199,7 @@ void organizerMenu(User& organizer) {
             clearScreen();
             cout << "===== EDIT MY EVENTS =====\n\n";
 
-            bool hasEvents = false;
-            for (const Event& event : events) {
-                if (event.organizerId == organizer.id) {
-                    hasEvents = true;
-                    break;
-                }
-            }
+            bool hasEvents = events.hasEventsBy(organizer.id);
 
             if (!hasEvents) {
                 cout << "You haven't created any events yet.\n";
@@ -218,15 +215,14 @@ void organizerMenu(User& organizer) {
                 << setw(30) << "Time" << setw(30) << "Location" << endl;
             cout << string(100, '-') << endl;
 
-            for (const Event& event : events) {
-                if (event.organizerId == organizer.id) {
-                    cout << setw(5) << event.id
-                        << setw(25) << event.title.substr(0, 20)
-                        << setw(12) << event.date
-                        << setw(30) << event.time
-                        << setw(30) << event.location.substr(0, 25)
-                        << endl;
-                }
+            for (const Event* mine : events.byOrganizer(organizer.id)) {
+                const Event& event = *mine;
+                cout << setw(5) << event.id
+                    << setw(25) << event.title.substr(0, 20)
+                    << setw(12) << event.dateText()
+                    << setw(30) << event.timeText()
+                    << setw(30) << event.location.str().substr(0, 25)
+                    << endl;
             }
 
             cout << "\nEnter ID of event to edit (0 to exit): ";
@@ -238,169 +234,157 @@ void organizerMenu(User& organizer) {
                 break;
             }
 
-            bool found = false;
-            for (Event& event : events) {
-                if (event.id == eventId && event.organizerId == organizer.id) {
-                    found = true;
-                    double oldFee = event.totalFee;
-
-                    cout << "\nCurrent Details:\n";
-                    cout << "Title: " << event.title << endl;
-                    cout << "Description: " << event.description << endl;
-                    cout << "Date: " << event.date << endl;
-                    cout << "Time: " << event.time << endl;
-                    cout << "Location: " << event.location << endl;
-                    cout << "Expected Participants: " << event.expectedParticipants << endl;
-                    cout << "Theme Planner: "
-                        << (event.themeName == "None" ? "None" : event.themeName + " (Vendor: " + event.vendorName + ")") << endl;
-                    cout << "Theme Cost: RM " << fixed << setprecision(2) << event.themeCost << endl;
-                    cout << "Total Fee: RM " << fixed << setprecision(2) << event.totalFee << endl;
-
-                    cout << "\nEnter new details (leave blank to keep current):\n";
-                    cin.ignore(numeric_limits<streamsize>::max(), '\n'); 
-
-                    string input;
-                    cout << "Title [" << event.title << "]: ";
+            EventService service(events);
+            const Event* match = events.find(eventId);
+            if (match && match->organizerId == organizer.id) {
+                // Edit a copy; it only replaces the stored event once the change is paid for
+                Event event = *match;
+                double oldFee = event.totalFee;
+
+                cout << "\nCurrent Details:\n";
+                cout << "Title: " << event.title << endl;
+                cout << "Description: " << event.description << endl;
+                cout << "Date: " << event.dateText() << endl;
+                cout << "Time: " << event.timeText() << endl;
+                cout << "Location: " << event.location << endl;
+                cout << "Expected Participants: " << event.expectedParticipants << endl;
+                cout << "Theme Planner: "
+                    << (event.themeName == "None" ? "None" : event.themeName.str() + " (Vendor: " + event.vendorName.str() + ")") << endl;
+                cout << "Theme Cost: RM " << fixed << setprecision(2) << event.themeCost << endl;
+                cout << "Total Fee: RM " << fixed << setprecision(2) << event.totalFee << endl;
+
+                cout << "\nEnter new details (leave blank to keep current):\n";
+                cin.ignore(numeric_limits<streamsize>::max(), '\n'); 
+
+                string input;
+                cout << "Title [" << event.title << "]: ";
+                getline(cin, input);
+                if (!input.empty()) event.title = input;
+
+                cout << "Description [" << event.description << "]: ";
+                getline(cin, input);
+                if (!input.empty()) event.description = input;
+
+                do {
+                    cout << "Date [" << event.dateText() << "]: ";
                     getline(cin, input);
-                    if (!input.empty()) event.title = input;
-
-                    cout << "Description [" << event.description << "]: ";
-                    getline(cin, input);
-                    if (!input.empty()) event.description = input;
-
-                    do {
-                        cout << "Date [" << event.date << "]: ";
-                        getline(cin, input);
-                        if (!input.empty()) {
-                            if (isValidDate(input)) {
-                                event.date = input;
-                                break;
-                            }
-                            else {
-                                cout << "Invalid date format. Please use YYYY-MM-DD.\n";
-                            }
+                    if (!input.empty()) {
+                        if (isValidDate(input)) {
+                            event.setDateText(input);
+                            break;
                         }
-                        else break;
-                    } while (true);
-
-                    cout << "\nSelect time slot (leave blank to keep current):\n";
-                    for (int i = 0; i < Event::slotOptions.size(); i++)
-                        cout << i + 1 << ". " << Event::slotOptions[i] << endl;
-
-                    string timeInput;
-                    getline(cin, timeInput);
-                    if (!timeInput.empty()) {
-                        int slotChoice = stoi(timeInput);
-                        if (slotChoice >= 1 && slotChoice <= Event::slotOptions.size()) {
-                            string newTime = Event::slotOptions[slotChoice - 1];
-                            bool conflict = false;
-                            for (const auto& ev : events) {
-                                if (ev.id != event.id &&
-                                    ev.date == event.date &&
-                                    ev.time == newTime &&
-                                    ev.location == event.location) {
-                                    conflict = true;
-                                    break;
-                                }
-                            }
-                            if (conflict) {
-                                cout << "Conflict: Another event is already scheduled at this time & location.\n";
-                            }
-                            else {
-                                event.time = newTime;
-                            }
+                        else {
+                            cout << "Invalid date format. Please use YYYY-MM-DD.\n";
                         }
                     }
-
-                    cout << "\nSelect location (leave blank to keep current):\n";
-                    cout << "1. 1st Floor Banquet Hall\n";
-                    cout << "2. 2nd Floor Banquet Hall\n";
-                    cout << "3. 3rd Floor Banquet Hall\n";
-                    cout << "Choice: ";
-                    string locInput;
-                    getline(cin, locInput);
-                    if (!locInput.empty()) {
-                        switch (stoi(locInput)) {
-                        case 1: event.location = "1st Floor Banquet Hall"; break;
-                        case 2: event.location = "2nd Floor Banquet Hall"; break;
-                        case 3: event.location = "3rd Floor Banquet Hall"; break;
+                    else break;
+                } while (true);
+
+                cout << "\nSelect time slot (leave blank to keep current):\n";
+                for (int i = 0; i < Event::slotOptions.size(); i++)
+                    cout << i + 1 << ". " << Event::slotOptions[i] << endl;
+
+                string timeInput;
+                getline(cin, timeInput);
+                if (!timeInput.empty()) {
+                    int slotChoice = stoi(timeInput);
+                    if (slotChoice >= 1 && slotChoice <= Event::slotOptions.size()) {
+                        TimeSlot newTime = static_cast<TimeSlot>(slotChoice - 1);
+                        if (!events.schedule().isFree(event.location, event.date, newTime, event.id)) {
+                            cout << "Conflict: Another event is already scheduled at this time & location.\n";
                         }
-                    }
-
-                    cout << "\nExpected Participants [" << event.expectedParticipants << "]: ";
-                    getline(cin, input);
-                    if (!input.empty()) {
-                        try {
-                            int num = stoi(input);
-                            if (num > 0 && num <= 100) {
-                                event.expectedParticipants = num;
-                            }
-                            else {
-                                cout << "Invalid number. Must be between 1 and 100.\n";
-                            }
-                        }
-                        catch (...) {
-                            cout << "Invalid input.\n";
+                        else {
+                            event.time = newTime;
+                            event.legacyTime.clear();
                         }
                     }
+                }
 
-                    cout << "\nChange Theme & Decoration Planner? (y/n): ";
-                    char themeChangeChoice = getYesNoInput();
-                    string themeName = event.themeName;
-                    string vendorName = event.vendorName;
-
-                    if (themeChangeChoice == 'y' || themeChangeChoice == 'Y') {
-                        double newThemeCost = themeMenu(themeName, vendorName);
+                cout << "\nSelect location (leave blank to keep current):\n";
+                cout << "1. 1st Floor Banquet Hall\n";
+                cout << "2. 2nd Floor Banquet Hall\n";
+                cout << "3. 3rd Floor Banquet Hall\n";
+                cout << "Choice: ";
+                string locInput;
+                getline(cin, locInput);
+                if (!locInput.empty()) {
+                    int locChoice = stoi(locInput);
+                    if (locChoice >= 1 && locChoice <= HALL_COUNT) event.location = HALLS[locChoice - 1].name;
+                }
 
-                        if (themeName.empty() || vendorName.empty()) {
-                            cout << "You selected 'No decoration package'.\n";
-                            event.themeName = "None";
-                            event.vendorName = "None";
-                            event.themeCost = 0.0;
+                cout << "\nExpected Participants [" << event.expectedParticipants << "]: ";
+                getline(cin, input);
+                if (!input.empty()) {
+                    try {
+                        int num = stoi(input);
+                        if (num > 0 && num <= 100) {
+                            event.expectedParticipants = num;
                         }
                         else {
-                            event.themeName = themeName;
-                            event.vendorName = vendorName;
-                            event.themeCost = newThemeCost;
+                            cout << "Invalid number. Must be between 1 and 100.\n";
                         }
                     }
+                    catch (...) {
+                        cout << "Invalid input.\n";
+                    }
+                }
 
-                    auto getVenueCost = [](const string& location) {
-                        if (location.find("1st") != string::npos) return 50;
-                        if (location.find("2nd") != string::npos) return 75;
-                        if (location.find("3rd") != string::npos) return 100;
-                        return 0;
-                        };
+                cout << "\nChange Theme & Decoration Planner? (y/n): ";
+                char themeChangeChoice = getYesNoInput();
+                InternedString themeName = event.themeName;
+                InternedString vendorName = event.vendorName;
 
-                    int venueCost = getVenueCost(event.location);
-                    event.totalFee = calculateTotalFee(venueCost, event.expectedParticipants, event.themeCost);
+                if (themeChangeChoice == 'y' || themeChangeChoice == 'Y') {
+                    double newThemeCost = themeMenu(themeName, vendorName);
 
-                    cout << "\nUpdated Total Fee: RM " << fixed << setprecision(2) << event.totalFee << endl;
+                    if (themeName.empty() || vendorName.empty()) {
+                        cout << "You selected 'No decoration package'.\n";
+                        event.themeName = "None";
+                        event.vendorName = "None";
+                        event.themeCost = 0.0;
+                    }
+                    else {
+                        event.themeName = themeName;
+                        event.vendorName = vendorName;
+                        event.themeCost = newThemeCost;
+                    }
+                }
 
-                    if (event.totalFee > oldFee) {
-                        double extra = event.totalFee - oldFee;
-                        cout << "\nThe event cost increased. You need to pay an extra RM" << extra << ".\n";
+                ServiceResult quote = service.quoteEvent(event);
+                if (!quote.ok()) {
+                    cout << "\nEvent changes were not saved: " << quote.message << ".\n";
+                }
+                else if (event.totalFee > oldFee) {
+                    cout << "\nUpdated Total Fee: RM " << fixed << setprecision(2) << event.totalFee << endl;
+                    double extra = event.totalFee - oldFee;
+                    cout << "\nThe event cost increased. You need to pay an extra RM" << extra << ".\n";
 
-                        // Only proceed if extra payment succeeds
-                        if (ProcessPayment(extra)) {
-                            saveEventsToFile(events);
+                    // Only proceed if extra payment succeeds
+                    if (ProcessPayment(extra)) {
+                        ServiceResult result = service.updateEvent(event, organizer.id);
+                        if (result.ok()) {
                             cout << "\nEvent updated successfully!\n";
                         }
                         else {
-                            // revert changes if payment failed
-                            event.totalFee = oldFee;
-                            cout << "\nPayment failed or cancelled. Event changes were not saved.\n";
+                            cout << "\nEvent changes were not saved: " << result.message << ".\n";
                         }
                     }
                     else {
-                        saveEventsToFile(events);
+                        cout << "\nPayment failed or cancelled. Event changes were not saved.\n";
+                    }
+                }
+                else {
+                    cout << "\nUpdated Total Fee: RM " << fixed << setprecision(2) << event.totalFee << endl;
+                    ServiceResult result = service.updateEvent(event, organizer.id);
+                    if (result.ok()) {
                         cout << "\nNo extra payment required. Event updated successfully!\n";
                     }
-                    break;
+                    else {
+                        cout << "\nEvent changes were not saved: " << result.message << ".\n";
+                    }
                 }
             }
-
-            if (!found) {
+            else {
                 cout << "Event not found or you don't have permission to edit it.\n";
             }
             cout << "\nPress Enter to continue...";
@@ -415,13 +399,7 @@ void organizerMenu(User& organizer) {
             cout << "===== DELETE MY EVENTS =====\n\n";
 
             // Check if user has events
-            bool hasEvents = false;
-            for (const Event& event : events) {
-                if (event.organizerId == organizer.id) {
-                    hasEvents = true;
-                    break;
-                }
-            }
+            bool hasEvents = events.hasEventsBy(organizer.id);
 
             if (!hasEvents) {
                 cout << "You haven't created any events yet.\n";
@@ -438,17 +416,16 @@ void organizerMenu(User& organizer) {
                 << setw(25) << "Location" << endl;
             cout << string(95, '-') << endl;
 
-            for (const Event& event : events) {
-                if (event.organizerId == organizer.id) {
-                    string slotDisplay = event.time.empty() ? "-" : event.time;
+            for (const Event* mine : events.byOrganizer(organizer.id)) {
+                const Event& event = *mine;
+                string slotDisplay = event.timeText().empty() ? "-" : event.timeText();
 
-                    cout << left << setw(5) << event.id
-                        << setw(25) << (event.title.empty() ? "(No Title)" : event.title.substr(0, 20))
-                        << setw(12) << (event.date.empty() ? "-" : event.date)
-                        << setw(25) << slotDisplay
-                        << setw(25) << (event.location.empty() ? "-" : event.location.substr(0, 22))
-                        << endl;
-                }
+                cout << left << setw(5) << event.id
+                    << setw(25) << (event.title.empty() ? "(No Title)" : event.title.substr(0, 20))
+                    << setw(12) << (event.dateText().empty() ? "-" : event.dateText())
+                    << setw(25) << slotDisplay
+                    << setw(25) << (event.location.empty() ? "-" : event.location.str().substr(0, 22))
+                    << endl;
             }
 
             cout << "\nEnter ID of event to delete (0 to cancel): ";
@@ -460,30 +437,23 @@ void organizerMenu(User& organizer) {
                 break;
             }
 
-            bool found = false;
-            for (auto it = events.begin(); it != events.end(); ++it) {
-                if (it->id == eventId && it->organizerId == organizer.id) {
-                    found = true;
-
-                    cout << "Are you sure you want to delete '"
-                        << (it->title.empty() ? "(No Title)" : it->title)
-                        << "'? (y/n): ";
-                    char confirm;
-                    cin >> confirm;
+            const Event* match = events.find(eventId);
+            if (match && match->organizerId == organizer.id) {
+                cout << "Are you sure you want to delete '"
+                    << (match->title.empty() ? "(No Title)" : match->title)
+                    << "'? (y/n): ";
+                char confirm;
+                cin >> confirm;
 
-                    if (tolower(confirm) == 'y') {
-                        events.erase(it);
-                        saveEventsToFile(events);
-                        cout << "Event deleted successfully.\n";
-                    }
-                    else {
-                        cout << "Deletion canceled.\n";
-                    }
-                    break;
+                if (tolower(confirm) == 'y') {
+                    EventService(events).deleteEvent(eventId, organizer.id);
+                    cout << "Event deleted successfully.\n";
+                }
+                else {
+                    cout << "Deletion canceled.\n";
                 }
             }
-
-            if (!found) {
+            else {
                 cout << "Event not found or you don't have permission to delete it.\n";
             }
 
@@ -496,13 +466,7 @@ void organizerMenu(User& organizer) {
             clearScreen();
             cout << "===== MY EVENTS =====\n\n";
 
-            bool hasEvents = false;
-            for (const Event& event : events) {
-                if (event.organizerId == organizer.id) {
-                    hasEvents = true;
-                    break;
-                }
-            }
+            bool hasEvents = events.hasEventsBy(organizer.id);
 
             if (!hasEvents) {
                 cout << "You haven't created any events yet.\n";
@@ -522,19 +486,18 @@ void organizerMenu(User& organizer) {
 
             cout << string(130, '-') << endl;
 
-            for (const Event& event : events) {
-                if (event.organizerId == organizer.id) {
-                    string slotDisplay = event.time.empty() ? "-" : event.time;
-
-                    cout << setw(5) << event.id
-                        << setw(25) << (event.title.empty() ? "(No Title)" : event.title.substr(0, 20))
-                        << setw(12) << (event.date.empty() ? "-" : event.date)
-                        << setw(25) << slotDisplay
-                        << setw(20) << (event.location.empty() ? "-" : event.location.substr(0, 18))
-                        << setw(25) << (event.description.empty() ? "-" : event.description.substr(0, 25))
-                        << setw(15) << event.expectedParticipants
-                        << endl;
-                }
+            for (const Event* mine : events.byOrganizer(organizer.id)) {
+                const Event& event = *mine;
+                string slotDisplay = event.timeText().empty() ? "-" : event.timeText();
+
+                cout << setw(5) << event.id
+                    << setw(25) << (event.title.empty() ? "(No Title)" : event.title.substr(0, 20))
+                    << setw(12) << (event.dateText().empty() ? "-" : event.dateText())
+                    << setw(25) << slotDisplay
+                    << setw(20) << (event.location.empty() ? "-" : event.location.str().substr(0, 18))
+                    << setw(25) << (event.description.empty() ? "-" : event.description.substr(0, 25))
+                    << setw(15) << event.expectedParticipants
+                    << endl;
             }
 
             cout << "\nEnter an event ID to view details (or 0 to go back): ";
@@ -543,77 +506,64 @@ void organizerMenu(User& organizer) {
             if (eventId == 0) break;
 
            
-                bool found = false;
-                for (const Event& event : events) {
-                    if (event.id == eventId && event.organizerId == organizer.id) {
-                        found = true;
-                        clearScreen();
-                        cout << "===== EVENT DETAILS =====\n\n";
-                        cout << "ID: " << event.id << endl;
-                        cout << "Title: " << (event.title.empty() ? "-" : event.title) << endl;
-                        cout << "Description: " << (event.description.empty() ? "-" : event.description) << endl;
-                        cout << "Date: " << (event.date.empty() ? "-" : event.date) << endl;
-                        cout << "Time Slot: " << (event.time.empty() ? "-" : event.time) << endl;
-                        cout << "Location: " << (event.location.empty() ? "-" : event.location) << endl;
-                        cout << "Expected Participants: " << event.expectedParticipants << endl;
-
-                        if (event.themeName.empty() || event.themeName == "None") {
-                            cout << "Theme Planner: None\n";
-                            cout << "Theme Cost: RM0.00\n";
-                        }
-                        else {
-                            cout << "Theme Planner: " << event.themeName
-                                << " (Vendor: " << event.vendorName << ")\n";
-                            cout << "Theme Cost: RM"
-                                << fixed << setprecision(2)
-                                << event.themeCost << endl;
-                        }
+                const Event* match = events.find(eventId);
+                if (match && match->organizerId == organizer.id) {
+                    const Event& event = *match;
+                    clearScreen();
+                    cout << "===== EVENT DETAILS =====\n\n";
+                    cout << "ID: " << event.id << endl;
+                    cout << "Title: " << (event.title.empty() ? "-" : event.title) << endl;
+                    cout << "Description: " << (event.description.empty() ? "-" : event.description) << endl;
+                    cout << "Date: " << (event.dateText().empty() ? "-" : event.dateText()) << endl;
+                    cout << "Time Slot: " << (event.timeText().empty() ? "-" : event.timeText()) << endl;
+                    cout << "Location: " << (event.location.empty() ? "-" : event.location.str()) << endl;
+                    cout << "Expected Participants: " << event.expectedParticipants << endl;
 
-                        int venueCost = 0;
-                        if (event.location.find("1st Floor") != string::npos)
-                            venueCost = 50;
-                        else if (event.location.find("2nd Floor") != string::npos)
-                            venueCost = 75;
-                        else if (event.location.find("3rd Floor") != string::npos)
-                            venueCost = 100;
-
-                        double totalFee = venueCost
-                            + (event.expectedParticipants * 5.0)
-                            + event.themeCost;
-                        cout << "Venue Cost: RM" << venueCost << endl;
-                        cout << "Total Fee: RM"
+                    if (event.themeName.empty() || event.themeName == "None") {
+                        cout << "Theme Planner: None\n";
+                        cout << "Theme Cost: RM0.00\n";
+                    }
+                    else {
+                        cout << "Theme Planner: " << event.themeName
+                            << " (Vendor: " << event.vendorName << ")\n";
+                        cout << "Theme Cost: RM"
                             << fixed << setprecision(2)
-                            << totalFee << endl;
+                            << event.themeCost << endl;
+                    }
 
-                        cout << "Marketing: "
-                            << (event.marketing.empty() ? "-" : event.marketing)
-                            << endl;
+                    int hallCost = venueCost(event.location);
 
-                        cout << "\nAttendees (" << event.attendees.size() << "):\n";
-                        if (event.attendees.empty()) {
-                            cout << "No attendees yet.\n";
-                        }
-                        else {
-                            cout << setw(5) << "ID"
-                                << setw(20) << "Name"
-                                << setw(25) << "Email" << endl;
-                            cout << string(60, '-') << endl;
-                            for (int userId : event.attendees) {
-                                for (const User& user : users) {
-                                    if (user.id == userId) {
-                                        cout << setw(5) << user.id
-                                            << setw(20) << user.name
-                                            << setw(25) << user.email << endl;
-                                        break;
-                                    }
-                                }
+                    double totalFee = hallCost
+                        + (event.expectedParticipants * 5.0)
+                        + event.themeCost;
+                    cout << "Venue Cost: RM" << hallCost << endl;
+                    cout << "Total Fee: RM"
+                        << fixed << setprecision(2)
+                        << totalFee << endl;
+
+                    cout << "Marketing: "
+                        << (event.marketing.empty() ? "-" : event.marketing)
+                        << endl;
+
+                    cout << "\nAttendees (" << event.attendees.size() << "):\n";
+                    if (event.attendees.empty()) {
+                        cout << "No attendees yet.\n";
+                    }
+                    else {
+                        cout << setw(5) << "ID"
+                            << setw(20) << "Name"
+                            << setw(25) << "Email" << endl;
+                        cout << string(60, '-') << endl;
+                        for (int userId : event.attendees) {
+                            if (const User* user = findUserById(userId)) {
+                                cout << setw(5) << user->id
+                                    << setw(20) << user->name
+                                    << setw(25) << user->email << endl;
                             }
                         }
-                        break;
                     }
                 }
-
-                if (!found) {
+                else {
                     cout << "Event not found or you don't have permission to view it.\n";
                 }
                 pauseScreen();
@@ -641,15 +591,9 @@ void organizerMenu(User& organizer) {
             cout << "Enter attendee username to register: ";
             cin >> attendeeUsername;
 
-            User* attendee = nullptr;
-            for (User& user : users) {
-                if (user.username == attendeeUsername && user.role == "attendee") {
-                    attendee = &user;
-                    break;
-                }
-            }
+            User* attendee = findUserByUsername(attendeeUsername);
 
-            if (!attendee) {
+            if (!attendee || attendee->role != ROLE_ATTENDEE) {
                 cout << "Attendee not found or invalid username.\n";
                 pauseScreen();
                 break;
@@ -676,12 +620,13 @@ void organizerMenu(User& organizer) {
             cout << string(80, '-') << endl;
 
             bool hasEvents = false;
-            for (const Event& event : events) {
-                if (event.organizerId == organizer.id && event.status == EventStatus::UPCOMING) {
+            for (const Event* mine : events.byOrganizer(organizer.id)) {
+                const Event& event = *mine;
+                if (event.status == EventStatus::UPCOMING) {
                     hasEvents = true;
                     cout << setw(5) << event.id << setw(25) << event.title.substr(0, 20)
-                        << setw(12) << event.date << setw(10) << event.time
-                        << setw(20) << event.location.substr(0, 15) << endl;
+                        << setw(12) << event.dateText() << setw(10) << event.timeText()
+                        << setw(20) << event.location.str().substr(0, 15) << endl;
                 }
             }
 
@@ -699,37 +644,36 @@ void organizerMenu(User& organizer) {
                 cout << "Invalid input. Please enter a numeric ID: ";
             }
 
-            bool eventFound = false;
-            for (Event& event : events) {
-                if (event.id == eventId && event.organizerId == organizer.id) {
-                    eventFound = true;
+            const Event* match = events.find(eventId);
+            if (match && match->organizerId == organizer.id) {
+                const Event& event = *match;
+
+                if (event.attendees.contains(attendee->id)) {
+                    cout << attendee->name << " is already registered for '" << event.title << "'.\n";
+                }
+                else {
+                    // Show final confirmation
+                    cout << "\nRegister " << attendee->name << " for event: " << event.title << endl;
+                    cout << "Date: " << event.dateText() << " at " << event.timeText() << endl;
+                    cout << "Location: " << event.location << endl;
+                    cout << "\nConfirm registration? (y/n): ";
 
-                    auto it = find(event.attendees.begin(), event.attendees.end(), attendee->id);
-                    if (it != event.attendees.end()) {
-                        cout << attendee->name << " is already registered for '" << event.title << "'.\n";
+                    char confirmFinal = getYesNoInput();
+                    if (tolower(confirmFinal) != 'y') {
+                        cout << "Registration cancelled.\n";
                     }
                     else {
-                        // Show final confirmation
-                        cout << "\nRegister " << attendee->name << " for event: " << event.title << endl;
-                        cout << "Date: " << event.date << " at " << event.time << endl;
-                        cout << "Location: " << event.location << endl;
-                        cout << "\nConfirm registration? (y/n): ";
-
-                        char confirmFinal = getYesNoInput();
-                        if (tolower(confirmFinal) == 'y') {
-                            event.attendees.push_back(attendee->id);
-                            saveEventsToFile(events);
+                        ServiceResult result = EventService(events).registerAttendee(event.id, attendee->id, organizer.id);
+                        if (result.ok()) {
                             cout << "Successfully registered " << attendee->name << " for '" << event.title << "'!\n";
                         }
                         else {
-                            cout << "Registration cancelled.\n";
+                            cout << "Registration failed: " << result.message << ".\n";
                         }
                     }
-                    break;
                 }
             }
-
-            if (!eventFound) {
+            else {
                 cout << "Event not found or you don't have permission to modify it.\n";
             }
 
@@ -740,26 +684,32 @@ void organizerMenu(User& organizer) {
             clearScreen();
             cout << "===== EVENT RATINGS & COMPLAINTS =====\n\n";
 
-            bool hasEvents = false;
-            for (const Event& ev : events) {
-                if (ev.organizerId == organizer.id) {
-                    hasEvents = true;
-                    cout << "Event ID: " << ev.id << " | " << ev.title << endl;
-                    cout << "Average Rating: " << fixed << setprecision(1) << ev.averageRating << "\n";
+            RatingStats overall = events.ratingStatsFor(organizer.id);
+            if (overall.count > 0) {
+                cout << "All your events\n";
+                printRatingSummary(overall);
+                cout << string(80, '=') << endl;
+            }
 
-                    if (ev.ratings.empty()) {
-                        cout << "  No ratings or complaints yet.\n";
-                    }
-                    else {
-                        for (const Rating& r : ev.ratings) {
-                            cout << "  Rating: " << r.rating
-                                << " | Comment: " << r.comment
-                                << " | Complaint: " << (r.complaint.empty() ? "-" : r.complaint)
-                                << "\n";
-                        }
+            bool hasEvents = false;
+            for (const Event* mine : events.byOrganizer(organizer.id)) {
+                const Event& ev = *mine;
+                hasEvents = true;
+                cout << "Event ID: " << ev.id << " | " << ev.title << endl;
+                printRatingSummary(ev.ratingStats);
+
+                if (ev.ratings.empty()) {
+                    cout << "  No ratings or complaints yet.\n";
+                }
+                else {
+                    for (const Rating& r : ev.ratings) {
+                        cout << "  Rating: " << r.rating
+                            << " | Comment: " << r.comment
+                            << " | Complaint: " << (r.complaint.empty() ? "-" : r.complaint)
+                            << "\n";
                     }
-                    cout << string(80, '-') << endl;
                 }
+                cout << string(80, '-') << endl;
             }
 
             if (!hasEvents) {
@@ -775,11 +725,10 @@ void organizerMenu(User& organizer) {
             cout << "===== VIEW RECEIPT =====\n\n";
 
             bool hasEvents = false;
-            for (const Event& ev : events) {
-                if (ev.organizerId == organizer.id) {
-                    hasEvents = true;
-                    cout << "Event ID: " << ev.id << " | " << ev.title << endl;
-                }
+            for (const Event* mine : events.byOrganizer(organizer.id)) {
+                const Event& ev = *mine;
+                hasEvents = true;
+                cout << "Event ID: " << ev.id << " | " << ev.title << endl;
             }
 
             if (!hasEvents) {
@@ -796,53 +745,42 @@ void organizerMenu(User& organizer) {
                 break;
             }
 
-            bool found = false;
-            for (const Event& ev : events) {
-                if (ev.id == eventId && ev.organizerId == organizer.id) {
-                    found = true;
-                    clearScreen();
+            const Event* match = events.find(eventId);
+            if (match && match->organizerId == organizer.id) {
+                const Event& ev = *match;
+                clearScreen();
 
-                    cout << "=====================================\n";
-                    cout << "              EVENT RECEIPT          \n";
-                    cout << "=====================================\n";
-                    cout << "Receipt No. : R" << ev.id << "2025\n";
-                    cout << "Organizer   : " << organizer.name << endl;
-                    cout << "Event Title : " << ev.title << endl;
-                    cout << "Date & Time : " << ev.date << " | " << ev.time << endl;
-                    cout << "Location    : " << ev.location << endl;
-                    cout << "Theme       : " << ev.themeName << endl;
-                    cout << "Participants: " << ev.expectedParticipants << endl;
-                    cout << "-------------------------------------\n";
-
-                    // Calculate costs
-                    int venueCost = 0;
-                    if (ev.location.find("1st Floor") != string::npos)
-                        venueCost = 50;
-                    else if (ev.location.find("2nd Floor") != string::npos)
-                        venueCost = 75;
-                    else if (ev.location.find("3rd Floor") != string::npos)
-                        venueCost = 100;
-
-                    double participantCost = ev.expectedParticipants * 5.0;
-                    double themeCost = ev.themeCost;
-                    double totalFee = venueCost + participantCost + themeCost;
-
-                    cout << "Venue Cost        : RM" << fixed << setprecision(2) << venueCost << endl;
-                    cout << "Participant Cost  : RM" << fixed << setprecision(2) << participantCost << endl;
-                    cout << "Theme & Decoration: RM" << fixed << setprecision(2) << themeCost << endl;
-                    cout << "-------------------------------------\n";
-                    cout << "TOTAL PAID        : RM" << fixed << setprecision(2) << totalFee << endl;
-                    cout << "=====================================\n";
-                    cout << "   Payment Status : SUCCESSFUL       \n";
-                    cout << "=====================================\n";
-                    cout << "        THANK YOU FOR BOOKING        \n";
-                    cout << "=====================================\n";
+                cout << "=====================================\n";
+                cout << "              EVENT RECEIPT          \n";
+                cout << "=====================================\n";
+                cout << "Receipt No. : R" << ev.id << "2025\n";
+                cout << "Organizer   : " << organizer.name << endl;
+                cout << "Event Title : " << ev.title << endl;
+                cout << "Date & Time : " << ev.dateText() << " | " << ev.timeText() << endl;
+                cout << "Location    : " << ev.location << endl;
+                cout << "Theme       : " << ev.themeName << endl;
+                cout << "Participants: " << ev.expectedParticipants << endl;
+                cout << "-------------------------------------\n";
+
+                // Calculate costs
+                int hallCost = venueCost(ev.location);
+                double participantCost = ev.expectedParticipants * 5.0;
+                double themeCost = ev.themeCost;
+                double totalFee = hallCost + participantCost + themeCost;
+
+                cout << "Venue Cost        : RM" << fixed << setprecision(2) << hallCost << endl;
+                cout << "Participant Cost  : RM" << fixed << setprecision(2) << participantCost << endl;
+                cout << "Theme & Decoration: RM" << fixed << setprecision(2) << themeCost << endl;
+                cout << "-------------------------------------\n";
+                cout << "TOTAL PAID        : RM" << fixed << setprecision(2) << totalFee << endl;
+                cout << "=====================================\n";
+                cout << "   Payment Status : SUCCESSFUL       \n";
+                cout << "=====================================\n";
+                cout << "        THANK YOU FOR BOOKING        \n";
+                cout << "=====================================\n";
 
-                    break;
-                }
             }
-
-            if (!found) {
+            else {
                 cout << "Event not found or you don't have permission to view it.\n";
             }
 
@@ -0,0 +1,160 @@
+#include "recordparser.h"
+#include <charconv>
+
+using namespace std;
+
+bool RecordTokenizer::skip(char c) {
+    if (atEnd() || line_[pos_] != c) return false;
+    pos_++;
+    return true;
+}
+
+string_view RecordTokenizer::text(string_view delims) {
+    size_t end = line_.find_first_of(delims, pos_);
+    if (end == string_view::npos) end = line_.size();
+    string_view out = line_.substr(pos_, end - pos_);
+    pos_ = end;
+    return out;
+}
+
+void RecordTokenizer::readText(string& out, string_view delims) {
+    if (!escaped_) {
+        out.assign(text(delims));
+        return;
+    }
+
+    out.clear();
+    while (!atEnd() && delims.find(line_[pos_]) == string_view::npos) {
+        char c = line_[pos_++];
+        if (c == '\\' && !atEnd()) {
+            c = line_[pos_++];
+            if (c == 'n') c = '\n';
+            else if (c == 'r') c = '\r';
+        }
+        out += c;
+    }
+}
+
+bool RecordTokenizer::endsNumber(const char* end, string_view delims) {
+    size_t next = static_cast<size_t>(end - line_.data());
+    if (next < line_.size() && delims.find(line_[next]) == string_view::npos) {
+        pos_ = next;
+        return fail("unexpected character after number");
+    }
+    pos_ = next;
+    return true;
+}
+
+bool RecordTokenizer::readInt(int& out, string_view delims) {
+    const char* first = line_.data() + pos_;
+    const char* last = line_.data() + line_.size();
+    from_chars_result r = from_chars(first, last, out);
+    if (r.ec == errc::result_out_of_range) return fail("number out of range");
+    if (r.ec != errc()) return fail("expected an integer");
+    return endsNumber(r.ptr, delims);
+}
+
+bool RecordTokenizer::readDouble(double& out, string_view delims) {
+    const char* first = line_.data() + pos_;
+    const char* last = line_.data() + line_.size();
+    from_chars_result r = from_chars(first, last, out);
+    if (r.ec == errc::result_out_of_range) return fail("number out of range");
+    if (r.ec != errc()) return fail("expected a number");
+    return endsNumber(r.ptr, delims);
+}
+
+bool RecordTokenizer::fail(const char* message) {
+    error_.column = column();
+    error_.message = message;
+    return false;
+}
+
+// Field order: id|title|description|date|time|location|organizerId|attendees|
+// expectedParticipants|totalFee|themeCost|themeName|vendorName|marketing|
+// status|averageRating|ratings
+bool parseEventRecord(string_view line, Event& ev, RecordError& error, bool unescape) {
+    RecordTokenizer in(line, unescape);
+    auto next = [&in]() {
+        return in.skip('|') || in.fail("missing fields (expected at least 16)");
+    };
+
+    string field;       // theme and vendor are unescaped here, then interned
+    bool ok = in.readInt(ev.id, "|") && next();
+    if (ok) {
+        in.readText(ev.title, "|");
+        ok = next();
+    }
+    if (ok) {
+        in.readText(ev.description, "|");
+        ok = next();
+    }
+    if (ok) {
+        ev.setDateText(in.text("|"));
+        ok = next();
+    }
+    if (ok) {
+        ev.setTimeText(in.text("|"));
+        ok = next();
+    }
+    if (ok) {
+        ev.location = in.text("|");
+        ok = next();
+    }
+    ok = ok && in.readInt(ev.organizerId, "|") && next();
+
+    // Attendees: comma-separated ids, empty entries ignored
+    while (ok && in.peek() != '|' && !in.atEnd()) {
+        if (in.skip(',')) continue;
+        int attendeeId;
+        ok = in.readInt(attendeeId, ",|");
+        if (ok) ev.attendees.insert(attendeeId);
+    }
+    ok = ok && next();
+
+    ok = ok && in.readInt(ev.expectedParticipants, "|") && next();
+    ok = ok && in.readDouble(ev.totalFee, "|") && next();
+    ok = ok && in.readDouble(ev.themeCost, "|") && next();
+    if (ok) {
+        in.readText(field, "|");
+        ev.themeName = field;
+        ok = next();
+    }
+    if (ok) {
+        in.readText(field, "|");
+        ev.vendorName = field;
+        ok = next();
+    }
+    if (ok) {
+        in.readText(ev.marketing, "|");
+        ok = next();
+    }
+    if (ok) {
+        ev.status = stringToStatus(in.text("|"));
+        ok = next();
+    }
+    ok = ok && in.readDouble(ev.averageRating, "|");
+
+    // Ratings: attendeeId,rating,comment,complaint entries separated by ';'
+    if (ok && in.skip('|')) {
+        while (ok && in.peek() != '|' && !in.atEnd()) {
+            Rating rating;
+            ok = in.readInt(rating.attendeeId, ",;|") &&
+                (in.skip(',') || in.fail("expected ',' after rating attendee")) &&
+                in.readDouble(rating.rating, ",;|");
+            if (!ok) break;
+
+            if (in.skip(',')) {
+                in.readText(rating.comment, ",;|");
+                if (in.skip(',')) in.readText(rating.complaint, ",;|");
+            }
+            in.text(";|");      // anything after the complaint is ignored
+            ev.ratings.push_back(move(rating));
+
+            if (in.skip(';') && (in.peek() == '|' || in.atEnd())) break;
+        }
+    }
+
+    if (!ok) error = in.error();
+    else ev.ratingStats.rebuild(ev.ratings);
+    return ok;
+}
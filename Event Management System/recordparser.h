@@ -0,0 +1,63 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include "event.h"
+
+using namespace std;
+
+// Characters written with a backslash in front inside free-text fields
+// (a newline is written as backslash + 'n', a carriage return as backslash + 'r')
+const char ESCAPED_CHARS[] = "\\|,;\n\r";
+
+// First line of an events.dat written with escaped free text. Older files
+// have no header and are read literally, so a backslash there stays one.
+const char EVENTS_TEXT_HEADER[] = "#events 2";
+
+// Where and why a record was rejected. `message` is a string literal.
+struct RecordError {
+    size_t column = 0;      // 1-based
+    const char* message = "";
+};
+
+// Single-pass cursor over one line of the pipe/comma/semicolon format.
+//
+// Never allocates: fields come back as string_views into the line and
+// numbers are read in place with from_chars.
+class RecordTokenizer {
+public:
+    // `unescape` is false for files that predate escaping
+    RecordTokenizer(string_view line, bool unescape)
+        : line_(line), escaped_(unescape && line.find('\\') != string_view::npos) {}
+
+    bool atEnd() const { return pos_ >= line_.size(); }
+    char peek() const { return atEnd() ? '\0' : line_[pos_]; }
+    size_t column() const { return pos_ + 1; }
+
+    // Consumes `c` if it is the next character
+    bool skip(char c);
+    // Text up to (not including) the first of `delims` or the end of the line
+    string_view text(string_view delims);
+    // Same, for free-text fields: backslash escapes are undone (when unescaping),
+    // so an escaped delimiter is part of the text
+    void readText(string& out, string_view delims);
+    // The number must run right up to one of `delims` or the end of the line
+    bool readInt(int& out, string_view delims);
+    bool readDouble(double& out, string_view delims);
+
+    bool fail(const char* message);
+    const RecordError& error() const { return error_; }
+
+private:
+    bool endsNumber(const char* end, string_view delims);
+
+    string_view line_;
+    size_t pos_ = 0;
+    bool escaped_ = false;      // unescaping, and the line contains a backslash somewhere
+    RecordError error_;
+};
+
+// Parses one events.dat line into `ev`; `unescape` is true for files that
+// start with EVENTS_TEXT_HEADER. On failure `ev` is partially filled and
+// `error` says where the line went wrong.
+bool parseEventRecord(string_view line, Event& ev, RecordError& error, bool unescape);
@@ -0,0 +1,63 @@
+#include "registrationindex.h"
+#include <algorithm>
+
+using namespace std;
+
+// A user registers for few events, so each list is small and unordered:
+// removal swaps the last id into the gap
+
+static void eraseId(vector<int>& ids, int id) {
+    auto it = std::find(ids.begin(), ids.end(), id);
+    if (it == ids.end()) return;
+    *it = ids.back();
+    ids.pop_back();
+}
+
+void RegistrationIndex::add(int userId, int eventId) {
+    lock_guard<mutex> lock(mutex_);
+    eventsByUser_[userId].push_back(eventId);
+}
+
+void RegistrationIndex::remove(int userId, int eventId) {
+    lock_guard<mutex> lock(mutex_);
+    auto it = eventsByUser_.find(userId);
+    if (it == eventsByUser_.end()) return;
+    eraseId(it->second, eventId);
+    if (it->second.empty()) eventsByUser_.erase(it);
+}
+
+void RegistrationIndex::addEvent(const Event& ev) {
+    lock_guard<mutex> lock(mutex_);
+    for (int userId : ev.attendees) eventsByUser_[userId].push_back(ev.id);
+}
+
+void RegistrationIndex::removeEvent(const Event& ev) {
+    lock_guard<mutex> lock(mutex_);
+    for (int userId : ev.attendees) {
+        auto it = eventsByUser_.find(userId);
+        if (it == eventsByUser_.end()) continue;
+        eraseId(it->second, ev.id);
+        if (it->second.empty()) eventsByUser_.erase(it);
+    }
+}
+
+vector<int> RegistrationIndex::removeUser(int userId) {
+    lock_guard<mutex> lock(mutex_);
+    vector<int> eventIds;
+    auto it = eventsByUser_.find(userId);
+    if (it == eventsByUser_.end()) return eventIds;
+    eventIds = move(it->second);
+    eventsByUser_.erase(it);
+    return eventIds;
+}
+
+void RegistrationIndex::clear() {
+    lock_guard<mutex> lock(mutex_);
+    eventsByUser_.clear();
+}
+
+vector<int> RegistrationIndex::eventsOf(int userId) const {
+    lock_guard<mutex> lock(mutex_);
+    auto it = eventsByUser_.find(userId);
+    return it == eventsByUser_.end() ? vector<int>() : it->second;
+}
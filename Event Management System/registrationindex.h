@@ -0,0 +1,33 @@
+#pragma once
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "event.h"
+
+using namespace std;
+
+// Which events each user is registered for: the reverse of Event::attendees.
+//
+// "My registered events", cancellation and rating only need the handful of
+// events a user signed up for, so they read this instead of testing every
+// event's attendee set. The repository keeps it in step with every change to
+// an attendee set. Like the leaderboard it is shared by every event, so it
+// carries its own lock for the server's parallel registrations.
+class RegistrationIndex {
+public:
+    void add(int userId, int eventId);
+    void remove(int userId, int eventId);
+    // Every attendee of the event
+    void addEvent(const Event& ev);
+    void removeEvent(const Event& ev);
+    // Forgets the user and returns the ids of the events they were registered for
+    vector<int> removeUser(int userId);
+    void clear();
+
+    // In no particular order
+    vector<int> eventsOf(int userId) const;
+
+private:
+    unordered_map<int, vector<int>> eventsByUser_;
+    mutable mutex mutex_;
+};
@@ -0,0 +1,56 @@
+#include "scheduleindex.h"
+
+using namespace std;
+
+bool ScheduleKey::operator<(const ScheduleKey& other) const {
+    if (date != other.date) return date < other.date;
+    // Same venue is a pointer compare; text order only between venues
+    if (location != other.location) return location.str() < other.location.str();
+    return time < other.time;
+}
+
+void ScheduleIndex::add(const Event& ev) {
+    bookings_.emplace(ScheduleKey{ ev.date, ev.location, ev.time }, &ev);
+}
+
+void ScheduleIndex::remove(const Event& ev) {
+    auto range = bookings_.equal_range(ScheduleKey{ ev.date, ev.location, ev.time });
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == &ev) {
+            bookings_.erase(it);
+            return;
+        }
+    }
+}
+
+const Event* ScheduleIndex::bookedBy(InternedString location, CalendarDay date, TimeSlot time, int ignoreId) const {
+    auto range = bookings_.equal_range(ScheduleKey{ date, location, time });
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second->id != ignoreId) return it->second;
+    }
+    return nullptr;
+}
+
+vector<const Event*> ScheduleIndex::bookingsOn(CalendarDay date) const {
+    vector<const Event*> result;
+    for (auto it = bookings_.lower_bound(ScheduleKey{ date, InternedString(), TimeSlot::MORNING });
+        it != bookings_.end() && it->first.date == date; ++it) {
+        result.push_back(it->second);
+    }
+    return result;
+}
+
+vector<ScheduleKey> ScheduleIndex::freeSlots(InternedString location, CalendarDay fromDate, int days) const {
+    vector<ScheduleKey> result;
+    if (fromDate.empty()) return result;
+    for (int d = 0; d < days; d++) {
+        CalendarDay date = fromDate.plusDays(d);
+        for (int slot = 0; slot < TIME_SLOT_COUNT; slot++) {
+            TimeSlot time = static_cast<TimeSlot>(slot);
+            if (isFree(location, date, time)) {
+                result.push_back(ScheduleKey{ date, location, time });
+            }
+        }
+    }
+    return result;
+}
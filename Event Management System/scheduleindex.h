@@ -0,0 +1,47 @@
+#pragma once
+#include <map>
+#include <string>
+#include <vector>
+#include "event.h"
+#include "internedstring.h"
+
+using namespace std;
+
+// A bookable venue/date/slot combination; a key is a day, a pool pointer
+// and a slot, so conflict checks never copy or compare venue text
+struct ScheduleKey {
+    CalendarDay date;
+    InternedString location;
+    TimeSlot time;
+
+    bool operator<(const ScheduleKey& other) const;
+};
+
+// Ordered index of bookings keyed by (date, venue, slot).
+//
+// Conflict checks are a single O(log n) lookup, and every booking on one date
+// sits in a contiguous range, so "what is booked on D" and "which slots are
+// free at venue X over the next N days" never touch unrelated events.
+// Entries point at events owned by EventRepository, which keeps them in sync.
+class ScheduleIndex {
+public:
+    void add(const Event& ev);
+    void remove(const Event& ev);
+    void clear() { bookings_.clear(); }
+
+    // Another event holding this venue/date/slot, or nullptr if it is free
+    const Event* bookedBy(InternedString location, CalendarDay date, TimeSlot time, int ignoreId = 0) const;
+    bool isFree(InternedString location, CalendarDay date, TimeSlot time, int ignoreId = 0) const {
+        return bookedBy(location, date, time, ignoreId) == nullptr;
+    }
+
+    // Every booking on the given date, ordered by venue then slot
+    vector<const Event*> bookingsOn(CalendarDay date) const;
+
+    // Free slots at one venue for `days` consecutive days starting at fromDate
+    vector<ScheduleKey> freeSlots(InternedString location, CalendarDay fromDate, int days) const;
+
+private:
+    // Duplicates are possible in legacy data, hence multimap
+    multimap<ScheduleKey, const Event*> bookings_;
+};
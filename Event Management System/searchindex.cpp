@@ -0,0 +1,199 @@
+#include "searchindex.h"
+#include <algorithm>
+
+using namespace std;
+
+// Where a word appears decides how much it counts
+static const int TITLE_WEIGHT = 5;
+static const int LOCATION_WEIGHT = 3;
+static const int PACKAGE_WEIGHT = 2;       // themeName, vendorName
+static const int DESCRIPTION_WEIGHT = 1;
+
+static bool isWordChar(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+}
+
+// Calls fn(word) for each lower-cased word; `word` is reused between calls
+template <typename Fn>
+static void forEachWord(string_view text, string& word, Fn fn) {
+    size_t i = 0;
+    while (i < text.size()) {
+        while (i < text.size() && !isWordChar(text[i])) i++;
+        if (i == text.size()) break;
+
+        word.clear();
+        for (; i < text.size() && isWordChar(text[i]); i++) {
+            char c = text[i];
+            word += c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+        }
+        fn(word);
+    }
+}
+
+vector<string> searchWords(string_view text) {
+    vector<string> words;
+    string word;
+    forEachWord(text, word, [&words](const string& w) { words.push_back(w); });
+    return words;
+}
+
+vector<pair<string, int>> SearchIndex::wordsOf(const Event& ev) {
+    vector<pair<string, int>> words;
+    string buffer;
+    auto addField = [&words, &buffer](const string& text, int weight) {
+        forEachWord(text, buffer, [&words, weight](const string& word) { words.emplace_back(word, weight); });
+    };
+    addField(ev.title, TITLE_WEIGHT);
+    addField(ev.location, LOCATION_WEIGHT);
+    // "None" is the placeholder for no package, not something to search for
+    if (ev.themeName != "None") addField(ev.themeName, PACKAGE_WEIGHT);
+    if (ev.vendorName != "None") addField(ev.vendorName, PACKAGE_WEIGHT);
+    addField(ev.description, DESCRIPTION_WEIGHT);
+
+    // One entry per word, its weights summed
+    sort(words.begin(), words.end());
+    size_t out = 0;
+    for (size_t i = 0; i < words.size(); i++) {
+        if (out > 0 && words[out - 1].first == words[i].first) words[out - 1].second += words[i].second;
+        else {
+            if (out != i) words[out] = move(words[i]);
+            out++;
+        }
+    }
+    words.resize(out);
+    return words;
+}
+
+void SearchIndex::add(const Event& ev) {
+    for (const auto& word : wordsOf(ev)) {
+        auto it = postings_.find(word.first);
+        if (it == postings_.end()) it = postings_.emplace(word.first, PostingList()).first;
+        vector<Posting>& list = it->second.postings;
+        // Ids mostly arrive in increasing order, so this is usually an append
+        if (list.empty() || list.back().eventId < ev.id) {
+            list.push_back(Posting{ ev.id, word.second });
+            continue;
+        }
+        auto pos = lower_bound(list.begin(), list.end(), ev.id, idBefore);
+        if (pos != list.end() && pos->eventId == ev.id) {
+            if (pos->weight == 0) it->second.removed--;
+            pos->weight = word.second;
+        }
+        else {
+            list.insert(pos, Posting{ ev.id, word.second });
+        }
+    }
+}
+
+void SearchIndex::remove(const Event& ev) {
+    for (const auto& word : wordsOf(ev)) {
+        auto it = postings_.find(word.first);
+        if (it == postings_.end()) continue;
+        PostingList& list = it->second;
+        auto pos = lower_bound(list.postings.begin(), list.postings.end(), ev.id, idBefore);
+        if (pos == list.postings.end() || pos->eventId != ev.id || pos->weight == 0) continue;
+        pos->weight = 0;
+        list.removed++;
+
+        if (list.live() == 0) {
+            postings_.erase(it);
+        }
+        else if (list.removed > list.live()) {
+            list.postings.erase(remove_if(list.postings.begin(), list.postings.end(),
+                [](const Posting& p) { return p.weight == 0; }), list.postings.end());
+            list.removed = 0;
+        }
+    }
+}
+
+vector<SearchHit> SearchIndex::termHits(const vector<pair<const PostingList*, int>>& lists) {
+    vector<SearchHit> hits;
+    for (const auto& list : lists) {
+        for (const Posting& p : list.first->postings) {
+            if (p.weight > 0) hits.push_back(SearchHit{ p.eventId, p.weight * list.second });
+        }
+    }
+    if (lists.size() < 2) return hits;
+
+    // Several words share the prefix: one hit per event, scores summed
+    sort(hits.begin(), hits.end(), [](const SearchHit& a, const SearchHit& b) { return a.eventId < b.eventId; });
+    size_t out = 0;
+    for (size_t i = 0; i < hits.size(); i++) {
+        if (out > 0 && hits[out - 1].eventId == hits[i].eventId) hits[out - 1].score += hits[i].score;
+        else hits[out++] = hits[i];
+    }
+    hits.resize(out);
+    return hits;
+}
+
+vector<SearchHit> SearchIndex::search(string_view query, size_t limit) const {
+    // Each query word with the posting lists it matches and their score factor
+    struct Term {
+        vector<pair<const PostingList*, int>> lists;
+        size_t postings = 0;
+    };
+    vector<Term> terms;
+    for (const string& word : searchWords(query)) {
+        Term term;
+        if (word.size() < MIN_PREFIX_LENGTH) {
+            auto it = postings_.find(word);
+            if (it != postings_.end()) term.lists.emplace_back(&it->second, 2);
+        }
+        else {
+            for (auto it = postings_.lower_bound(word);
+                it != postings_.end() && it->first.compare(0, word.size(), word) == 0; ++it) {
+                term.lists.emplace_back(&it->second, it->first.size() == word.size() ? 2 : 1);
+            }
+        }
+        for (const auto& list : term.lists) term.postings += list.first->live();
+        if (term.postings == 0) return {};
+        terms.push_back(move(term));
+    }
+    if (terms.empty()) return {};
+
+    // Start from the rarest word so the candidate set is small from the
+    // outset. Candidates stay sorted by event id, like the posting lists.
+    sort(terms.begin(), terms.end(), [](const Term& a, const Term& b) { return a.postings < b.postings; });
+    vector<SearchHit> hits = termHits(terms[0].lists);
+
+    for (size_t t = 1; t < terms.size() && !hits.empty(); t++) {
+        const Term& term = terms[t];
+        size_t out = 0;
+        if (hits.size() * term.lists.size() < term.postings) {
+            // Few candidates: look each one up in the word's lists
+            for (const SearchHit& hit : hits) {
+                int score = 0;
+                for (const auto& list : term.lists) {
+                    const vector<Posting>& postings = list.first->postings;
+                    auto pos = lower_bound(postings.begin(), postings.end(), hit.eventId, idBefore);
+                    if (pos != postings.end() && pos->eventId == hit.eventId) score += pos->weight * list.second;
+                }
+                if (score > 0) hits[out++] = SearchHit{ hit.eventId, hit.score + score };
+            }
+        }
+        else {
+            // Many candidates: walk both id-sorted sequences together
+            vector<SearchHit> other = termHits(term.lists);
+            size_t j = 0;
+            for (const SearchHit& hit : hits) {
+                while (j < other.size() && other[j].eventId < hit.eventId) j++;
+                if (j < other.size() && other[j].eventId == hit.eventId) {
+                    hits[out++] = SearchHit{ hit.eventId, hit.score + other[j].score };
+                }
+            }
+        }
+        hits.resize(out);
+    }
+
+    auto better = [](const SearchHit& a, const SearchHit& b) {
+        return a.score != b.score ? a.score > b.score : a.eventId < b.eventId;
+    };
+    if (hits.size() > limit) {
+        partial_sort(hits.begin(), hits.begin() + limit, hits.end(), better);
+        hits.resize(limit);
+    }
+    else {
+        sort(hits.begin(), hits.end(), better);
+    }
+    return hits;
+}
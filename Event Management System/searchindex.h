@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "event.h"
+
+using namespace std;
+
+struct SearchHit {
+    int eventId;
+    int score;
+};
+
+// Inverted index over the words of each event's title, description,
+// location, themeName and vendorName.
+//
+// Words are runs of ASCII letters and digits, lower-cased. Each word maps to
+// the events containing it, weighted by where it appears (a title word
+// counts more than a description word). The words are kept in order, so a
+// prefix ("conf") is one contiguous range and "conf" finds "conference".
+// Entries are by event id; EventRepository keeps the index in step on
+// put() and remove().
+class SearchIndex {
+public:
+    void add(const Event& ev);
+    void remove(const Event& ev);
+    void clear() { postings_.clear(); }
+
+    // Events matching every word of the query, best first (ties: lowest id).
+    // A whole-word match scores twice a prefix match; query words shorter
+    // than MIN_PREFIX_LENGTH only match whole words.
+    vector<SearchHit> search(string_view query, size_t limit) const;
+
+    static const size_t MIN_PREFIX_LENGTH = 2;
+
+private:
+    struct Posting {
+        int eventId;
+        int weight;         // 0 once the event is removed
+    };
+    static bool idBefore(const Posting& p, int id) { return p.eventId < id; }
+
+    // Sorted by event id. Common words ("hall") list nearly every event, so
+    // a removal only zeroes the posting; the list is compacted once most of
+    // it is removed, which keeps deletes and edits O(log n).
+    struct PostingList {
+        vector<Posting> postings;
+        size_t removed = 0;
+
+        size_t live() const { return postings.size() - removed; }
+    };
+
+    // Every event in the lists, scores summed over them, sorted by event id.
+    // Each list comes with its score factor.
+    static vector<SearchHit> termHits(const vector<pair<const PostingList*, int>>& lists);
+    // Each word of one event with its weight summed over the fields, sorted
+    static vector<pair<string, int>> wordsOf(const Event& ev);
+
+    map<string, PostingList, less<>> postings_;
+};
+
+// Lower-cased words of free text, in order
+vector<string> searchWords(string_view text);
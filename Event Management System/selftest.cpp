@@ -0,0 +1,337 @@
+#include "selftest.h"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "event.h"
+#include "eventrepository.h"
+#include "eventservice.h"
+#include "eventstore.h"
+#include "journal.h"
+#include "recordparser.h"
+#include "user.h"
+
+using namespace std;
+
+extern vector<User> users;
+extern EventRepository events;
+
+static int checksRun = 0;
+static int checksFailed = 0;
+
+static void check(bool passed, const string& what) {
+    checksRun++;
+    if (!passed) {
+        checksFailed++;
+        cout << "FAIL: " << what << endl;
+    }
+}
+
+// Captures cout and cerr for its lifetime, so expected load messages and
+// warnings stay out of the report and can be checked
+struct CapturedOutput {
+    ostringstream text;
+    streambuf* out;
+    streambuf* err;
+
+    CapturedOutput() : out(cout.rdbuf(text.rdbuf())), err(cerr.rdbuf(text.rdbuf())) {}
+    ~CapturedOutput() {
+        cout.rdbuf(out);
+        cerr.rdbuf(err);
+    }
+};
+
+// A well-formed events.dat line with the given title text, as stored
+static string eventLine(int id, const string& title) {
+    return to_string(id) + '|' + title + "|desc|2026-05-05|09:00-12:00|1st Floor Banquet Hall|1000||10|100|0|None|None||UPCOMING|0|";
+}
+
+static void writeFile(const string& name, const string& text) {
+    ofstream out(name, ios::binary | ios::trunc);
+    out << text;
+}
+
+// ---------- tokenizer and events.dat ----------
+
+static void checkTokenizer() {
+    Event ev;
+    RecordError error;
+
+    check(parseEventRecord(eventLine(7, "Title"), ev, error, false) && ev.id == 7 && ev.title == "Title"
+        && ev.dateText() == "2026-05-05" && ev.time == TimeSlot::MORNING && ev.expectedParticipants == 10,
+        "tokenizer: parses a well-formed record");
+
+    ev = Event();
+    check(!parseEventRecord("12x" + eventLine(7, "Title").substr(1), ev, error, false)
+        && error.column == 3 && string(error.message) == "unexpected character after number",
+        "tokenizer: rejects trailing junk after a number, at its column");
+
+    string longLine = eventLine(7, "Title");
+    longLine.replace(0, 1, "99999999999");
+    ev = Event();
+    check(!parseEventRecord(longLine, ev, error, false) && string(error.message) == "number out of range",
+        "tokenizer: rejects an out-of-range id");
+
+    ev = Event();
+    check(!parseEventRecord("7|Title|desc", ev, error, false), "tokenizer: rejects a record with missing fields");
+
+    string out;
+    RecordTokenizer escaped("a\\|b\\,c\\nd|rest", true);
+    escaped.readText(out, "|");
+    check(out == "a|b,c\nd" && escaped.skip('|') && escaped.text("|") == "rest",
+        "tokenizer: undoes escapes and keeps escaped delimiters in the text");
+
+    RecordTokenizer literal("C:\\new|rest", false);
+    literal.readText(out, "|");
+    check(out == "C:\\new" && literal.skip('|'), "tokenizer: reads backslashes literally when not unescaping");
+}
+
+static void checkEventsTextFile() {
+    vector<Event> loaded;
+    {
+        CapturedOutput quiet;
+        writeFile("legacy.dat", eventLine(1, "C:\\new") + '\n');
+        loadEventsFromFile(loaded, "legacy.dat", 1);
+    }
+    check(loaded.size() == 1 && loaded[0].title == "C:\\new", "events.dat: a file without a header is read literally");
+
+    string warnings;
+    {
+        CapturedOutput captured;
+        writeFile("escaped.dat", string(EVENTS_TEXT_HEADER) + '\n' + eventLine(1, "C:\\\\new") + "\nbroken\n");
+        loadEventsFromFile(loaded, "escaped.dat", 1);
+        warnings = captured.text.str();
+    }
+    check(loaded.size() == 1 && loaded[0].title == "C:\\new", "events.dat: a file with the header is unescaped");
+    check(warnings.find("line 3,") != string::npos, "events.dat: warnings count the header as line 1");
+
+    vector<Event> original(1);
+    original[0].id = 3;
+    original[0].title = "pipes | commas, semicolons; back\\slash\nnewline";
+    original[0].setDateText("2025-02-30");
+    original[0].setTimeText("10:00-11:00");
+    saveEventsToFile(original, "roundtrip.dat");
+    {
+        CapturedOutput quiet;
+        loadEventsFromFile(loaded, "roundtrip.dat", 1);
+    }
+    check(loaded.size() == 1 && loaded[0].title == original[0].title && loaded[0].dateText() == "2025-02-30"
+        && loaded[0].timeText() == "10:00-11:00", "events.dat: save then load keeps special characters and legacy text");
+}
+
+// ---------- journal ----------
+
+static User makeUser(int id, const string& username, const InternedString& role) {
+    User user;
+    user.id = id;
+    user.username = username;
+    user.password = "pass1";
+    user.role = role;
+    user.name = username;
+    user.email = username + "@example.com";
+    return user;
+}
+
+static Event bookableEvent(const string& date, int slot, int capacity) {
+    Event ev;
+    ev.title = "Self test";
+    ev.organizerId = 1000;
+    ev.date = CalendarDay::parse(date);
+    ev.time = static_cast<TimeSlot>(slot);
+    ev.location = HALLS[0].name;
+    ev.expectedParticipants = capacity;
+    ev.themeName = "None";
+    ev.vendorName = "None";
+    return ev;
+}
+
+// The global users/events stand in for a running program that crashes
+// without a final save; a second load must rebuild the same state
+static void checkJournalReplay() {
+    users.clear();
+    users.push_back(makeUser(1000, "org", ROLE_ORGANIZER));
+    users.push_back(makeUser(1001, "att1", ROLE_ATTENDEE));
+    users.push_back(makeUser(1002, "att2", ROLE_ATTENDEE));
+    rebuildUserIndex();
+    events.load(vector<Event>());
+    check(checkpointJournal(users, events), "journal: writes the starting snapshot");
+
+    EventService service(events);
+    Event ev = bookableEvent("2026-06-01", 0, 10);
+    check(service.createEvent(ev).ok(), "journal: creates the event to replay");
+    check(service.registerAttendee(ev.id, 1001).ok(), "journal: registers the attendee to replay");
+    User late = makeUser(0, "late", ROLE_ATTENDEE);
+    check(service.registerUser(late).ok(), "journal: adds the user to replay");
+
+    vector<User> replayedUsers;
+    EventRepository replayed;
+    size_t applied;
+    {
+        CapturedOutput quiet;
+        loadUsersFromFile(replayedUsers, "users.dat", false);
+        vector<Event> loaded;
+        loadEventsFromBinaryFile(loaded);
+        replayed.load(move(loaded));
+        applied = replayJournal(replayedUsers, replayed, false);
+    }
+    const Event* restored = replayed.find(ev.id);
+    check(applied == 3, "journal: replays every record written since the snapshot");
+    check(restored && restored->attendees.contains(1001), "journal: an event and its registration survive a crash");
+    check(replayedUsers.size() == 4 && replayedUsers.back().username == "late", "journal: a new user survives a crash");
+
+    // A crash in the middle of an append leaves a torn record at the end
+    {
+        ofstream torn("events.journal", ios::binary | ios::app);
+        const char partial[] = { 16, 0, 0, 0, 1, 'x' };
+        torn.write(partial, sizeof(partial));
+    }
+    EventRepository again;
+    vector<User> againUsers;
+    string warnings;
+    {
+        CapturedOutput captured;
+        loadUsersFromFile(againUsers, "users.dat", false);
+        vector<Event> loaded;
+        loadEventsFromBinaryFile(loaded);
+        again.load(move(loaded));
+        applied = replayJournal(againUsers, again, false);
+        warnings = captured.text.str();
+    }
+    restored = again.find(ev.id);
+    check(applied == 3 && restored && restored->attendees.size() == 1,
+        "journal: a torn tail is ignored and the whole records before it still apply");
+    check(warnings.find("damaged") != string::npos, "journal: a torn tail is reported");
+
+    // Records are idempotent, so replaying on top of the result changes nothing
+    {
+        CapturedOutput quiet;
+        replayJournal(againUsers, again, false);
+    }
+    restored = again.find(ev.id);
+    check(restored && restored->attendees.size() == 1 && againUsers.size() == 4, "journal: replaying twice is harmless");
+
+    check(checkpointJournal(users, events) && !ifstream("events.journal"),
+        "journal: a checkpoint removes the journal");
+}
+
+// ---------- seats ----------
+
+static void checkLastSeat() {
+    const int ROUNDS = 200;
+    const int THREADS = 8;
+    const int CAPACITY = 5;
+
+    int roundsWithOneWinner = 0;
+    for (int round = 0; round < ROUNDS; round++) {
+        EventRepository repo;
+        Event ev;
+        ev.id = 1;
+        ev.expectedParticipants = CAPACITY;
+        repo.put(ev);
+        for (int userId = 1; userId < CAPACITY; userId++) repo.addAttendee(1, userId);
+
+        atomic<bool> go(false);
+        atomic<int> winners(0);
+        vector<thread> pool;
+        for (int t = 0; t < THREADS; t++) {
+            pool.emplace_back([&] {
+                while (!go) this_thread::yield();
+                if (repo.reserveSeat(1)) winners++;
+            });
+        }
+        go = true;
+        for (thread& worker : pool) worker.join();
+        if (winners == 1 && repo.seatsLeft(1) == 0) roundsWithOneWinner++;
+    }
+    check(roundsWithOneWinner == ROUNDS, "seats: exactly one of many racing claims gets the last seat");
+
+    EventRepository repo;
+    Event ev;
+    ev.id = 1;
+    ev.expectedParticipants = 2;
+    repo.put(ev);
+    repo.addAttendee(1, 1);
+    check(repo.reserveSeat(1) && !repo.reserveSeat(1), "seats: a full event refuses another claim");
+    repo.releaseSeat(1);
+    check(repo.seatsLeft(1) == 1 && repo.reserveSeat(1), "seats: a released claim can be taken again");
+    check(!repo.commitSeat(1, 1) && repo.seatsLeft(1) == 1,
+        "seats: committing an existing attendee gives the seat back");
+    check(repo.reserveSeat(1) && repo.commitSeat(1, 2) && repo.seatsLeft(1) == 0 && repo.find(1)->attendees.size() == 2,
+        "seats: a committed claim becomes an attendee");
+}
+
+// ---------- service rules ----------
+
+static void checkServiceRules() {
+    EventRepository repo;
+    EventService service(repo);
+
+    Event ev = bookableEvent("2025-02-30", 0, 10);
+    check(service.createEvent(ev).error == ServiceError::INVALID, "service: refuses a date that is not a real day");
+    ev = bookableEvent("2030-01-01", 0, 10);
+    check(service.createEvent(ev).error == ServiceError::INVALID, "service: refuses a date outside the booking window");
+    ev = bookableEvent("2026-07-01", 0, 0);
+    check(service.createEvent(ev).error == ServiceError::INVALID, "service: refuses zero participants");
+    ev = bookableEvent("2026-07-01", 0, 10);
+    ev.organizerId = 1001;
+    check(service.createEvent(ev).error == ServiceError::NOT_FOUND, "service: only an organizer can create an event");
+
+    Event first = bookableEvent("2026-07-01", 0, 1);
+    Event clash = bookableEvent("2026-07-01", 0, 10);
+    check(service.createEvent(first).ok() && service.createEvent(clash).error == ServiceError::CONFLICT,
+        "service: refuses a second booking of the same venue, date and slot");
+
+    check(service.registerAttendee(first.id, 1001).ok(), "service: registers an attendee");
+    check(service.registerAttendee(first.id, 1001).error == ServiceError::DUPLICATE, "service: refuses a duplicate registration");
+    check(service.registerAttendee(first.id, 1002).error == ServiceError::FULL, "service: refuses a registration once full");
+    check(service.registerAttendee(first.id, 1000).error == ServiceError::NOT_FOUND, "service: only attendees can register");
+
+    Event later = bookableEvent("2026-07-02", 1, 10);
+    check(service.createEvent(later).ok() && service.setStatus(later.id, EventStatus::COMPLETED).ok()
+        && service.registerAttendee(later.id, 1002).error == ServiceError::WRONG_STATUS,
+        "service: refuses a registration for an event that is not UPCOMING");
+
+    Event edit = *repo.find(first.id);
+    edit.expectedParticipants = 0;
+    check(service.updateEvent(edit, 1000).error == ServiceError::INVALID && repo.find(first.id)->expectedParticipants == 1,
+        "service: a refused update leaves the stored event alone");
+    edit = *repo.find(first.id);
+    check(service.updateEvent(edit, 1001).error != ServiceError::NONE, "service: only the owner can update an event");
+}
+
+int runSelfTest() {
+    checksRun = 0;
+    checksFailed = 0;
+
+    checkTokenizer();
+    checkLastSeat();
+
+    // Everything that reads or writes files runs in a scratch directory
+    error_code ec;
+    filesystem::path home = filesystem::current_path();
+    filesystem::path scratch = filesystem::temp_directory_path(ec)
+        / ("ems_self_test_" + to_string(chrono::steady_clock::now().time_since_epoch().count()));
+    if (ec || !filesystem::create_directories(scratch, ec)) {
+        cerr << "Error: Cannot create a scratch directory for the self-test" << endl;
+        return checksFailed + 1;
+    }
+    filesystem::current_path(scratch);
+    checkEventsTextFile();
+    checkJournalReplay();
+    checkServiceRules();
+    {
+        // Closes the journal the service checks appended to
+        CapturedOutput quiet;
+        checkpointJournal(users, events);
+    }
+    filesystem::current_path(home);
+    filesystem::remove_all(scratch, ec);
+
+    cout << checksRun - checksFailed << " of " << checksRun << " checks passed." << endl;
+    return checksFailed;
+}
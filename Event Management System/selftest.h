@@ -0,0 +1,16 @@
+#pragma once
+
+using namespace std;
+
+// Built-in regression checks: assignment2 --self-test
+//
+// Covers the events.dat tokenizer (bad numbers, trailing junk, escapes and
+// the "#events 2" header), journal replay after a crash and after a torn
+// write, the seat counter when many threads race for the last seat, and the
+// EventService booking rules. The journal and file checks run in a scratch
+// directory under the system temp directory, so the data files next to the
+// program are never touched.
+//
+// Prints one line per failed check and a summary. Returns the number of
+// failed checks.
+int runSelfTest();
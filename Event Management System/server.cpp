@@ -0,0 +1,348 @@
+#include "server.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "Ws2_32.lib")
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "batch.h"
+#include "eventrepository.h"
+#include "helpers.h"
+#include "journal.h"
+#include "mappedfile.h"
+#include "marketing.h"
+#include "metrics.h"
+#include "user.h"
+
+using namespace std;
+
+extern vector<User> users;
+extern EventRepository events;
+
+#ifdef _WIN32
+typedef SOCKET Socket;
+const int SHUT_READ = SD_RECEIVE;
+static void closeSocket(Socket s) { closesocket(s); }
+#else
+typedef int Socket;
+const Socket INVALID_SOCKET = -1;
+const int SHUT_READ = SHUT_RD;
+static void closeSocket(Socket s) { close(s); }
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+static shared_mutex catalogMutex;
+static mutex eventShards[EVENT_LOCK_SHARDS];
+
+static mutex& shardFor(int eventId) {
+    return eventShards[static_cast<unsigned>(eventId) % EVENT_LOCK_SHARDS];
+}
+
+// The accept loop wakes this often to notice "shutdown"; shutdown() and
+// closesocket() from another thread do not reliably wake accept() everywhere
+const int ACCEPT_POLL_MS = 200;
+// Pause after a failed accept (out of descriptors and the like) before retrying
+const int ACCEPT_RETRY_MS = 100;
+
+static atomic<bool> stopping(false);
+
+static mutex sessionsMutex;
+static condition_variable sessionsDone;
+static set<Socket> openSessions;
+static int activeSessions = 0;
+
+// Who a connection logged in as. Copies, since users may be added or
+// removed while the connection is open.
+struct Session {
+    int userId = 0;             // 0 until a successful login
+    string username;
+    InternedString role;
+};
+
+static bool toInt(string_view field, int& out) {
+    from_chars_result r = from_chars(field.data(), field.data() + field.size(), out);
+    return r.ec == errc() && r.ptr == field.data() + field.size();
+}
+
+// Caller holds the event's shard lock
+static string formatEvent(const Event& ev) {
+    return to_string(ev.id) + '|' + ev.title + '|' + ev.dateText() + '|' + ev.timeText() + '|' + ev.location.str() + '|'
+        + to_string(ev.attendees.size()) + '|' + to_string(ev.expectedParticipants) + '|'
+        + statusToString(ev.status) + '|' + to_string(ev.averageRating);
+}
+
+static string formatList(const vector<string>& rows) {
+    string reply = "ok " + to_string(rows.size());
+    for (const string& row : rows) reply += '\n' + row;
+    return reply;
+}
+
+// Commands that change a single existing event; everything else in batch.h
+// adds or removes events or users
+static bool changesOneEvent(string_view name) {
+    return name == "register" || name == "cancel" || name == "rate" || name == "status";
+}
+
+// "" when the session may run a batch command, else why not. Same rules as
+// the menus: admins manage users and any event, organizers only their own
+// events, and registrations and ratings are made only as yourself.
+// Caller holds the catalog lock.
+static string permissionError(const Session& session, const vector<string_view>& f) {
+    string_view name = f[0];
+    bool admin = session.role == ROLE_ADMIN;
+
+    if (name == "add-user") return admin ? "" : "only an admin can add users";
+    if (name == "create-event") {
+        return f.size() < 2 || f[1] == session.username ? "" : "events can only be created as yourself";
+    }
+    if (name == "register" || name == "cancel" || name == "rate") {
+        return f.size() < 3 || f[2] == session.username ? "" : "you can only act as yourself";
+    }
+    if (name == "status" || name == "delete-event") {
+        int eventId;
+        if (admin || f.size() < 2 || !toInt(f[1], eventId)) return "";
+        // A missing event is left for the command to report
+        const Event* ev = events.find(eventId);
+        if (ev && (session.role != ROLE_ORGANIZER || ev->organizerId != session.userId)) {
+            return "only the event's organizer or an admin can do that";
+        }
+    }
+    return "";
+}
+
+static string handleCommand(const string& line, Session& session, bool& quit) {
+    vector<string_view> f;
+    splitFields(line, "|", f);
+    if (f.empty()) return "error empty command";
+    string_view name = f[0];
+
+    if (name == "quit") {
+        quit = true;
+        return "ok bye";
+    }
+
+    if (name == "login") {
+        if (f.size() != 3) return "error expected login|username|password";
+        shared_lock<shared_mutex> catalog(catalogMutex);
+        const User* user = findUserByUsername(string(f[1]));
+        if (!user || user->password != f[2]) return "error invalid username or password";
+        session.userId = user->id;
+        session.username = user->username;
+        session.role = user->role;
+        return "ok " + to_string(user->id) + ' ' + user->role.str();
+    }
+
+    if (session.userId == 0) return "error log in first";
+
+    if (name == "shutdown") {
+        if (session.role != ROLE_ADMIN) return "error only an admin can shut the server down";
+        quit = true;
+        stopping = true;
+        return "ok shutting down";
+    }
+
+    if (name == "list") {
+        vector<string> rows;
+        shared_lock<shared_mutex> catalog(catalogMutex);
+        for (const Event* ev : events.byStatus(EventStatus::UPCOMING)) {
+            lock_guard<mutex> shard(shardFor(ev->id));
+            // It may have moved on since the partition was read
+            if (ev->status == EventStatus::UPCOMING) rows.push_back(formatEvent(*ev));
+        }
+        return formatList(rows);
+    }
+
+    if (name == "show") {
+        int eventId;
+        if (f.size() != 2 || !toInt(f[1], eventId)) return "error expected show|event id";
+        shared_lock<shared_mutex> catalog(catalogMutex);
+        const Event* ev = events.find(eventId);
+        if (!ev) return "error event not found";
+        lock_guard<mutex> shard(shardFor(eventId));
+        return "ok " + formatEvent(*ev);
+    }
+
+    if (name == "top") {
+        vector<string> rows;
+        shared_lock<shared_mutex> catalog(catalogMutex);
+        for (const Event* ev : events.leaderboard().top(TOP_EVENT_BANNER_SIZE)) {
+            lock_guard<mutex> shard(shardFor(ev->id));
+            rows.push_back(formatEvent(*ev));
+        }
+        return formatList(rows);
+    }
+
+    if (name == "metrics") {
+        shared_lock<shared_mutex> catalog(catalogMutex);
+        return formatList(metricsSnapshot(events));
+    }
+
+    string reply, error;
+    int eventId;
+    if (changesOneEvent(name) && f.size() > 1 && toInt(f[1], eventId)) {
+        shared_lock<shared_mutex> catalog(catalogMutex);
+        error = permissionError(session, f);
+        if (!error.empty()) return "error " + error;
+        // A sold-out event turns registrations away without queueing on its shard
+        if (name == "register" && events.find(eventId) && events.seatsLeft(eventId) == 0) {
+            return "error event is full";
+        }
+        lock_guard<mutex> shard(shardFor(eventId));
+        error = runBatchCommand(line, reply);
+    }
+    else {
+        unique_lock<shared_mutex> catalog(catalogMutex);
+        error = permissionError(session, f);
+        if (!error.empty()) return "error " + error;
+        error = runBatchCommand(line, reply);
+    }
+
+    // Compaction snapshots the live data, so nothing else may run meanwhile
+    if (journalCompactionDue()) {
+        unique_lock<shared_mutex> catalog(catalogMutex);
+        if (journalCompactionDue()) compactJournal();
+    }
+
+    if (!error.empty()) return "error " + error;
+    return reply.empty() ? "ok" : "ok " + reply;
+}
+
+static bool sendAll(Socket client, const string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        int n = send(client, data.data() + sent, static_cast<int>(data.size() - sent), MSG_NOSIGNAL);
+        if (n <= 0) return false;
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+static void serveSession(Socket client) {
+    string pending;
+    char buffer[4096];
+    bool quit = false;
+    Session session;
+
+    while (!quit) {
+        int n = recv(client, buffer, sizeof(buffer), 0);
+        if (n <= 0) break;
+        pending.append(buffer, static_cast<size_t>(n));
+
+        size_t start = 0, newline;
+        while (!quit && (newline = pending.find('\n', start)) != string::npos) {
+            string line = pending.substr(start, newline - start);
+            start = newline + 1;
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line.empty()) continue;
+
+            if (!sendAll(client, handleCommand(line, session, quit) + '\n')) quit = true;
+        }
+        pending.erase(0, start);
+    }
+
+    lock_guard<mutex> lock(sessionsMutex);
+    openSessions.erase(client);
+    closeSocket(client);
+    activeSessions--;
+    sessionsDone.notify_all();
+}
+
+// 1 when a connection is waiting, 0 on timeout, -1 on error
+static int waitForClient(Socket listener, int timeoutMs) {
+    fd_set ready;
+    FD_ZERO(&ready);
+    FD_SET(listener, &ready);
+    timeval timeout = { 0, timeoutMs * 1000 };
+    int n = select(static_cast<int>(listener) + 1, &ready, nullptr, nullptr, &timeout);
+    return n < 0 ? -1 : n;
+}
+
+int runServer(int port) {
+#ifdef _WIN32
+    WSADATA wsa;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) {
+        cerr << "Error: Cannot start Winsock" << endl;
+        return 1;
+    }
+#endif
+
+    Socket listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (listener == INVALID_SOCKET) {
+        cerr << "Error: Cannot create the server socket" << endl;
+        return 1;
+    }
+    int reuse = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<unsigned short>(port));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, SOMAXCONN) != 0) {
+        cerr << "Error: Cannot listen on 127.0.0.1:" << port << endl;
+        closeSocket(listener);
+        return 1;
+    }
+
+    setJournalAutoCompaction(false);
+    stopping = false;
+    cout << "Serving on 127.0.0.1:" << port << " (send \"shutdown\" to stop)" << endl;
+
+    while (!stopping) {
+        int ready = waitForClient(listener, ACCEPT_POLL_MS);
+        if (ready == 0) continue;
+        Socket client = ready > 0 ? accept(listener, nullptr, nullptr) : INVALID_SOCKET;
+        if (client == INVALID_SOCKET) {
+            this_thread::sleep_for(chrono::milliseconds(ACCEPT_RETRY_MS));
+            continue;
+        }
+
+        lock_guard<mutex> lock(sessionsMutex);
+        if (stopping) {
+            closeSocket(client);
+            break;
+        }
+        openSessions.insert(client);
+        activeSessions++;
+        thread(serveSession, client).detach();
+    }
+    closeSocket(listener);
+
+    // Let sessions finish the command they are on, then wait for them to close
+    {
+        unique_lock<mutex> lock(sessionsMutex);
+        for (Socket session : openSessions) shutdown(session, SHUT_READ);
+        sessionsDone.wait(lock, [] { return activeSessions == 0; });
+    }
+    setJournalAutoCompaction(true);
+
+#ifdef _WIN32
+    WSACleanup();
+#endif
+    cout << "Server stopped." << endl;
+    return 0;
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+
+using namespace std;
+
+// Shared booking desk: assignment2 --serve [port]
+//
+// Serves many sessions at once on 127.0.0.1:<port> against the one in-memory
+// dataset. A session sends one command per line and gets back one reply line,
+// "ok[ text]" or "error <reason>"; list-style replies are "ok <n>" followed by
+// n lines.
+//
+//   login|username|password
+//   every batch command (see batch.h)
+//   list                  upcoming events: id|title|date|time|location|attendees|expected|status|rating
+//   show|event id         one event, same fields
+//   top                   the top-event banner ranking, same fields
+//   metrics               the dashboard counters (see metrics.h)
+//   quit                  close this session
+//   shutdown              stop the server; the caller saves the data (admin only)
+//
+// Everything but login and quit needs a login first, and then follows the
+// menus' rules: add-user is admin only, status and delete-event need the
+// event's organizer or an admin, and create-event, register, cancel and rate
+// are accepted only for the logged-in username.
+//
+// Locking: a reader-writer lock over the catalog (which events and users
+// exist) is held exclusively only to create or delete events and users, and
+// shared by everything else. A change to one event also takes that event's
+// shard lock, so registrations for events in different shards never wait on
+// each other. Readers take the shard lock of each event while they format it.
+const int DEFAULT_SERVER_PORT = 5050;
+const size_t EVENT_LOCK_SHARDS = 64;
+
+// Returns once a client sends "shutdown" and every session has finished.
+int runServer(int port = DEFAULT_SERVER_PORT);
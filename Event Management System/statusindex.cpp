@@ -0,0 +1,70 @@
+#include "statusindex.h"
+
+using namespace std;
+
+static const size_t WORD_BITS = 64;
+
+static void setBit(vector<uint64_t>& bits, size_t slot) {
+    size_t word = slot / WORD_BITS;
+    if (word >= bits.size()) bits.resize(word + 1, 0);
+    bits[word] |= uint64_t(1) << (slot % WORD_BITS);
+}
+
+static bool clearBit(vector<uint64_t>& bits, size_t slot) {
+    size_t word = slot / WORD_BITS;
+    uint64_t mask = uint64_t(1) << (slot % WORD_BITS);
+    if (word >= bits.size() || !(bits[word] & mask)) return false;
+    bits[word] &= ~mask;
+    return true;
+}
+
+void StatusIndex::add(size_t slot, EventStatus status) {
+    lock_guard<mutex> lock(mutex_);
+    int s = static_cast<int>(status);
+    setBit(bits_[s], slot);
+    counts_[s]++;
+}
+
+void StatusIndex::remove(size_t slot, EventStatus status) {
+    lock_guard<mutex> lock(mutex_);
+    int s = static_cast<int>(status);
+    if (clearBit(bits_[s], slot)) counts_[s]--;
+}
+
+void StatusIndex::move(size_t slot, EventStatus from, EventStatus to) {
+    if (from == to) return;
+    lock_guard<mutex> lock(mutex_);
+    int f = static_cast<int>(from), t = static_cast<int>(to);
+    if (!clearBit(bits_[f], slot)) return;
+    counts_[f]--;
+    setBit(bits_[t], slot);
+    counts_[t]++;
+}
+
+void StatusIndex::clear() {
+    lock_guard<mutex> lock(mutex_);
+    for (int s = 0; s < EVENT_STATUS_COUNT; s++) {
+        bits_[s].clear();
+        counts_[s] = 0;
+    }
+}
+
+vector<size_t> StatusIndex::slotsWith(EventStatus status) const {
+    lock_guard<mutex> lock(mutex_);
+    int s = static_cast<int>(status);
+    vector<size_t> slots;
+    slots.reserve(counts_[s]);
+    const vector<uint64_t>& bits = bits_[s];
+    for (size_t word = 0; word < bits.size(); word++) {
+        size_t bit = word * WORD_BITS;
+        for (uint64_t w = bits[word]; w; w >>= 1, bit++) {
+            if (w & 1) slots.push_back(bit);
+        }
+    }
+    return slots;
+}
+
+size_t StatusIndex::count(EventStatus status) const {
+    lock_guard<mutex> lock(mutex_);
+    return counts_[static_cast<int>(status)];
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "event.h"
+
+using namespace std;
+
+// One bitset per EventStatus over the repository's slot numbers.
+//
+// A status-filtered listing walks only the set bits of its own status, in
+// slot (catalogue) order, and a count is a stored total. A status change
+// clears one bit and sets another under the index lock, so a reader never
+// sees an event in two partitions or in none. The server changes statuses
+// of different events in parallel, hence the lock; the bitsets are small
+// (one bit per slot per status), so contention is brief.
+class StatusIndex {
+public:
+    void add(size_t slot, EventStatus status);
+    void remove(size_t slot, EventStatus status);
+    void move(size_t slot, EventStatus from, EventStatus to);
+    void clear();
+
+    // Slots holding events of this status, ascending
+    vector<size_t> slotsWith(EventStatus status) const;
+    size_t count(EventStatus status) const;
+
+private:
+    vector<uint64_t> bits_[EVENT_STATUS_COUNT];
+    size_t counts_[EVENT_STATUS_COUNT] = {};
+    mutable mutex mutex_;
+};
@@ -26,7 +26,17 @@ string vendors[THEME_COUNT] = {
     "RetroVibe Planners"
 };
 
-double themeMenu(string& themeName, string& vendorName) {
+bool themePackage(int index, InternedString& themeName, InternedString& vendorName, double& cost) {
+    if (index < 0 || index >= THEME_COUNT) return false;
+
+    themeName = themes[index];
+    vendorName = vendors[index];
+    cost = 0;
+    for (int j = 0; j < ITEM_COUNT; j++) cost += costs[index][j];
+    return true;
+}
+
+double themeMenu(InternedString& themeName, InternedString& vendorName) {
     clearScreen();
     cout << "\n===== THEME & DECORATION PLANNER =====\n";
     cout << "Available Themes & Costs:\n\n";
@@ -2,7 +2,11 @@
 #define THEME_H
 
 #include <string>
+#include "internedstring.h"
 
-double themeMenu(std::string& themeName, std::string& vendorName);
+double themeMenu(InternedString& themeName, InternedString& vendorName);
+
+// Package `index` (0-based) of the planner menu; false past the last one
+bool themePackage(int index, InternedString& themeName, InternedString& vendorName, double& cost);
 
 #endif 
\ No newline at end of file
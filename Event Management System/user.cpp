@@ -1,17 +1,39 @@
 #include "user.h"
+#include "mappedfile.h"
 #include <fstream>
-#include <sstream>
 #include <iostream>
+#include <unordered_map>
 
 using namespace std;
 
 extern vector<User> users;
 
-void saveUsersToFile(const vector<User>& users) {
-    ofstream outFile("users.dat", ios::trunc);
+const InternedString ROLE_ADMIN("admin");
+const InternedString ROLE_ORGANIZER("organizer");
+const InternedString ROLE_ATTENDEE("attendee");
+
+// Positions into the global users vector
+static unordered_map<int, size_t> userPosById;
+static unordered_map<string, size_t> userPosByUsername;
+static UserCounts roleCounts;
+
+static void countRole(InternedString role, bool added) {
+    size_t* count = role == ROLE_ADMIN ? &roleCounts.admins
+        : role == ROLE_ORGANIZER ? &roleCounts.organizers
+        : role == ROLE_ATTENDEE ? &roleCounts.attendees : nullptr;
+    if (!count) return;
+    if (added) (*count)++;
+    else (*count)--;
+}
+
+bool saveUsersToFile(const vector<User>& users, const string& filename) {
+    // Written beside the real file and swapped in, like events.bin, so a crash
+    // or a full disk never leaves a torn users.dat
+    string tmpName = filename + ".tmp";
+    ofstream outFile(tmpName, ios::trunc);
     if (!outFile) {
-        cerr << "Error: Cannot open users.dat for writing!" << endl;
-        return;
+        cerr << "Error: Cannot open " << tmpName << " for writing!" << endl;
+        return false;
     }
 
     for (const User& user : users) {
@@ -25,46 +47,49 @@ void saveUsersToFile(const vector<User>& users) {
     }
 
     outFile.close();
+    if (!outFile) {
+        cerr << "Error: Failed writing " << tmpName << endl;
+        return false;
+    }
+    if (!replaceFile(tmpName, filename)) {
+        cerr << "Error: Cannot replace " << filename << endl;
+        return false;
+    }
+    return true;
 }
-void loadUsersFromFile(vector<User>& users) {
+void loadUsersFromFile(vector<User>& users, const string& filename, bool saveDefault) {
     users.clear();
-    ifstream inFile("users.dat");
+    MappedFile file;
 
-    if (!inFile) {
-        cout << "Note: users.dat not found. Creating default admin user." << endl;
+    if (!file.open(filename)) {
+        cout << "Note: " << filename << " not found. Creating default admin user." << endl;
         // Create default admin user
         User admin;
         admin.id = 1000;
         admin.username = "admin";
         admin.password = "admin123";
-        admin.role = "admin";
+        admin.role = ROLE_ADMIN;
         admin.name = "System Administrator";
         admin.email = "admin@events.com";
         users.push_back(admin);
-        saveUsersToFile(users);
+        if (saveDefault) saveUsersToFile(users, filename);
         return;
     }
 
-    string line;
+    string_view rest = file.view();
+    users.reserve(count(rest.begin(), rest.end(), '\n') + 1);
+
+    string_view line;
     int lineNumber = 0;
+    vector<string_view> tokens;
 
-    while (getline(inFile, line)) {
+    while (nextLine(rest, line)) {
         lineNumber++;
         if (line.empty()) continue;
 
-        // Replace any commas with pipes for consistency (if old format)
-        size_t commaPos = line.find(',');
-        if (commaPos != string::npos) {
-            replace(line.begin(), line.end(), ',', '|');
-        }
-
-        stringstream ss(line);
-        vector<string> tokens;
-        string token;
-
-        while (getline(ss, token, '|')) {
-            tokens.push_back(token);
-        }
+        // Old files used commas; treat them as pipes for consistency
+        bool oldFormat = line.find(',') != string_view::npos;
+        splitFields(line, oldFormat ? "|," : "|", tokens);
 
         if (tokens.size() != 6) {
             cerr << "Warning: Invalid user format on line " << lineNumber
@@ -75,14 +100,14 @@ void loadUsersFromFile(vector<User>& users) {
 
         try {
             User user;
-            user.id = stoi(tokens[0]);
-            user.username = tokens[1];
-            user.password = tokens[2];
+            user.id = stoi(string(tokens[0]));
+            user.username.assign(tokens[1]);
+            user.password.assign(tokens[2]);
             user.role = tokens[3];
-            user.name = tokens[4];
-            user.email = tokens[5];
+            user.name.assign(tokens[4]);
+            user.email.assign(tokens[5]);
 
-            users.push_back(user);
+            users.push_back(move(user));
         }
         catch (const exception& e) {
             cerr << "Warning: Error parsing user on line " << lineNumber
@@ -91,7 +116,7 @@ void loadUsersFromFile(vector<User>& users) {
         }
     }
 
-    inFile.close();
+    file.close();
 
     cout << "Loaded " << users.size() << " users:" << endl;
     for (const User& user : users) {
@@ -106,11 +131,11 @@ void loadUsersFromFile(vector<User>& users) {
         admin.id = 1000;
         admin.username = "admin";
         admin.password = "admin123";
-        admin.role = "admin";
+        admin.role = ROLE_ADMIN;
         admin.name = "System Administrator";
         admin.email = "admin@events.com";
         users.push_back(admin);
-        saveUsersToFile(users);
+        if (saveDefault) saveUsersToFile(users, filename);
     }
 }
 int generateUserId() {
@@ -130,3 +155,54 @@ int generateUserId() {
     return nextId++;
 }
 
+User* findUserById(int id) {
+    auto it = userPosById.find(id);
+    return it == userPosById.end() ? nullptr : &users[it->second];
+}
+
+User* findUserByUsername(const string& username) {
+    auto it = userPosByUsername.find(username);
+    return it == userPosByUsername.end() ? nullptr : &users[it->second];
+}
+
+void addUser(const User& user) {
+    users.push_back(user);
+    userPosById[user.id] = users.size() - 1;
+    userPosByUsername[user.username] = users.size() - 1;
+    countRole(user.role, true);
+}
+
+bool deleteUser(int id) {
+    auto it = userPosById.find(id);
+    if (it == userPosById.end()) return false;
+
+    size_t pos = it->second;
+    userPosById.erase(it);
+    userPosByUsername.erase(users[pos].username);
+    countRole(users[pos].role, false);
+    users.erase(users.begin() + pos);
+
+    // Everything after the erased slot moved down by one
+    for (size_t i = pos; i < users.size(); i++) {
+        userPosById[users[i].id] = i;
+        userPosByUsername[users[i].username] = i;
+    }
+    return true;
+}
+
+void rebuildUserIndex() {
+    userPosById.clear();
+    userPosByUsername.clear();
+    roleCounts = UserCounts();
+    userPosById.reserve(users.size());
+    userPosByUsername.reserve(users.size());
+    for (size_t i = 0; i < users.size(); i++) {
+        userPosById[users[i].id] = i;
+        userPosByUsername[users[i].username] = i;
+        countRole(users[i].role, true);
+    }
+}
+
+UserCounts userCountsByRole() {
+    return roleCounts;
+}
@@ -3,18 +3,42 @@
 #include <vector>
 #include <fstream>
 #include <algorithm>
+#include "internedstring.h"
 
 using namespace std;
 
+// Interned once, so checking a user's role is a pointer compare
+extern const InternedString ROLE_ADMIN;
+extern const InternedString ROLE_ORGANIZER;
+extern const InternedString ROLE_ATTENDEE;
+
 struct User {
     int id = 0;
     string username;
     string password;
-    string role; 
+    InternedString role;
     string name;
     string email;
 };
 
-void saveUsersToFile(const vector<User>& users);
-void loadUsersFromFile(vector<User>& users);
+bool saveUsersToFile(const vector<User>& users, const string& filename = "users.dat");
+// Falls back to a default admin when there are no users; `saveDefault` also
+// writes that admin to the file
+void loadUsersFromFile(vector<User>& users, const string& filename = "users.dat", bool saveDefault = true);
 int generateUserId();
+
+// Hash indexes over the global users vector (id -> User, username -> User).
+// Returned pointers stay valid until the next addUser/deleteUser.
+User* findUserById(int id);
+User* findUserByUsername(const string& username);
+void addUser(const User& user);
+bool deleteUser(int id);
+void rebuildUserIndex();
+
+// Users per role, kept in step by addUser/deleteUser/rebuildUserIndex
+struct UserCounts {
+    size_t admins = 0;
+    size_t organizers = 0;
+    size_t attendees = 0;
+};
+UserCounts userCountsByRole();
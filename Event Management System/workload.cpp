@@ -0,0 +1,171 @@
+#include "workload.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include "eventservice.h"
+#include "eventstore.h"
+#include "theme.h"
+
+using namespace std;
+
+static const char* const TITLES[] = {
+    "Wedding Reception", "Birthday Party", "Tech Conference", "Cooking Workshop",
+    "Charity Gala", "Product Launch", "Class Reunion", "Book Club"
+};
+
+// Free text deliberately full of the text format's separators
+static const char* const COMMENTS[] = {
+    "Great venue, friendly staff; would come again",
+    "Food ran out | queue was long",
+    "Loved it!",
+    "Sound was too loud; left early, sadly",
+    "Seats 12\\14 were broken",
+    "Good show\nbut it ran long",
+    ""
+};
+
+static const char* const COMPLAINTS[] = {
+    "Parking, again",
+    "Air-con broken; far too hot",
+    "Started late | 30 min"
+};
+
+static const char* const ADVERTS[] = {
+    "Early bird, 20% off | limited seats",
+    "Bring friends; groups of 5+ get a free drink",
+    "Doors open 30 min early"
+};
+
+template <typename T, size_t N>
+static const T& pick(const T (&pool)[N], mt19937& rng) {
+    return pool[uniform_int_distribution<size_t>(0, N - 1)(rng)];
+}
+
+ZipfSampler::ZipfSampler(size_t n, double s) {
+    cdf_.reserve(n);
+    double total = 0;
+    for (size_t k = 1; k <= n; k++) {
+        total += 1.0 / pow(static_cast<double>(k), s);
+        cdf_.push_back(total);
+    }
+}
+
+size_t ZipfSampler::operator()(mt19937& rng) const {
+    double u = uniform_real_distribution<double>(0.0, cdf_.back())(rng);
+    size_t rank = upper_bound(cdf_.begin(), cdf_.end(), u) - cdf_.begin() + 1;
+    return min(rank, cdf_.size());
+}
+
+void generateWorkload(const WorkloadOptions& options, vector<User>& users, vector<Event>& events) {
+    mt19937 rng(options.seed);
+    int userCount = options.users > 0 ? options.users : max(100, options.events / 10);
+    int organizers = max(1, userCount / 10);
+    int attendeePool = max(1, userCount - organizers);
+
+    users.clear();
+    users.reserve(userCount);
+    for (int i = 0; i < userCount; i++) {
+        User user;
+        user.id = 1000 + i;
+        user.username = "user" + to_string(i);
+        user.password = "pass" + to_string(i);
+        user.role = i < organizers ? ROLE_ORGANIZER : ROLE_ATTENDEE;
+        user.name = "User " + to_string(i);
+        user.email = user.username + "@example.com";
+        users.push_back(move(user));
+    }
+
+    // Rank 1 is the busiest organizer; attendee counts are rank - 1, so most events are small
+    ZipfSampler organizerRank(organizers, options.zipfExponent);
+    ZipfSampler attendeeRank(min(attendeePool, 100) + 1, options.zipfExponent);
+    uniform_int_distribution<int> pickAttendee(organizers, organizers + attendeePool - 1);
+    uniform_int_distribution<int> pickExpected(10, 100);
+    bernoulli_distribution slotTaken(max(0.05, min(1.0, options.occupancy)));
+    bernoulli_distribution rates(options.ratingShare);
+    bernoulli_distribution halfStar(0.3);
+    bernoulli_distribution chance(0.3);
+    discrete_distribution<int> stars({ 5, 10, 20, 35, 30 });
+
+    size_t slotsPerDay = HALL_COUNT * TIME_SLOT_COUNT;
+    size_t slot = 0;
+    CalendarDay day = CalendarDay::fromCivil(2025, 1, 1);
+    int completed = static_cast<int>(options.events * options.completedShare);
+
+    events.clear();
+    events.reserve(options.events);
+    for (int i = 0; i < options.events; i++) {
+        // Next taken booking in date order
+        for (;;) {
+            if (slot == slotsPerDay) {
+                day = day.plusDays(1);
+                slot = 0;
+            }
+            if (slotTaken(rng)) break;
+            slot++;
+        }
+        const Hall& hall = HALLS[slot / TIME_SLOT_COUNT];
+
+        Event ev;
+        ev.id = i + 1;
+        ev.title = string(pick(TITLES, rng)) + " #" + to_string(ev.id);
+        ev.organizerId = users[organizerRank(rng) - 1].id;
+        ev.description = "Hosted by organizer " + to_string(ev.organizerId);
+        ev.date = day;
+        ev.time = static_cast<TimeSlot>(slot % TIME_SLOT_COUNT);
+        ev.location = hall.name;
+        slot++;
+
+        size_t attendeeCount = attendeeRank(rng) - 1;
+        while (ev.attendees.size() < attendeeCount) {
+            ev.attendees.insert(users[pickAttendee(rng)].id);
+        }
+        ev.expectedParticipants = max(static_cast<int>(attendeeCount), pickExpected(rng));
+
+        ev.themeName = "None";
+        ev.vendorName = "None";
+        if (chance(rng)) themePackage(uniform_int_distribution<int>(0, 2)(rng), ev.themeName, ev.vendorName, ev.themeCost);
+        ev.totalFee = calculateTotalFee(hall.cost, ev.expectedParticipants, ev.themeCost);
+        if (chance(rng)) ev.marketing = pick(ADVERTS, rng);
+
+        if (i < completed) {
+            ev.status = EventStatus::COMPLETED;
+            for (int attendeeId : ev.attendees) {
+                if (!rates(rng)) continue;
+                Rating rating;
+                rating.attendeeId = attendeeId;
+                rating.rating = stars(rng) + 1;
+                if (rating.rating < 5 && halfStar(rng)) rating.rating += 0.5;
+                rating.comment = pick(COMMENTS, rng);
+                if (chance(rng)) rating.complaint = pick(COMPLAINTS, rng);
+                ev.ratings.push_back(move(rating));
+            }
+            ev.ratingStats.rebuild(ev.ratings);
+            ev.averageRating = ev.ratingStats.mean();
+        }
+        else if (i % 33 == 0) {
+            ev.status = EventStatus::CANCELLED;
+        }
+        events.push_back(move(ev));
+    }
+}
+
+int runWorkloadGenerator(const WorkloadOptions& options, const string& prefix) {
+    vector<User> users;
+    vector<Event> events;
+    generateWorkload(options, users, events);
+
+    size_t registrations = 0, ratings = 0;
+    for (const Event& ev : events) {
+        registrations += ev.attendees.size();
+        ratings += ev.ratings.size();
+    }
+
+    saveUsersToFile(users, prefix + "users.dat");
+    saveEventsToFile(events, prefix + "events.dat");
+    if (!saveEventsToBinaryFile(events, prefix + "events.bin")) return 1;
+
+    cout << "Wrote " << users.size() << " users and " << events.size() << " events ("
+        << registrations << " registrations, " << ratings << " ratings, seed " << options.seed
+        << ") to " << prefix << "users.dat, " << prefix << "events.dat and " << prefix << "events.bin" << endl;
+    return 0;
+}
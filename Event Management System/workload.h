@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+#include "event.h"
+#include "user.h"
+
+using namespace std;
+
+struct WorkloadOptions {
+    int events = 10000;
+    int users = 0;                  // 0 = one per ten events, at least 100
+    uint32_t seed = 12345;
+    double zipfExponent = 1.1;      // skew of attendees per event and of organizer activity
+    double occupancy = 0.9;         // share of hall/slot bookings taken on each day
+    double completedShare = 0.4;    // the earliest events are COMPLETED
+    double ratingShare = 0.4;       // chance that an attendee of a completed event rates it
+};
+
+// Draws ranks 1..n with P(k) proportional to 1 / k^s
+class ZipfSampler {
+public:
+    ZipfSampler(size_t n, double s);
+
+    size_t operator()(mt19937& rng) const;
+
+private:
+    vector<double> cdf_;
+};
+
+// Builds a production-shaped dataset, identical for the same options:
+//  - users "user<i>" / "pass<i>" with ids from 1000; the first tenth are organizers
+//  - a few organizers run most events and a few events draw most attendees
+//  - events fill the three halls x four slots of each day in date order,
+//    leaving (1 - occupancy) of the bookings free, so no two events clash
+//  - ratings skew towards 4-5 stars and their comments contain the text
+//    format's separators
+void generateWorkload(const WorkloadOptions& options, vector<User>& users, vector<Event>& events);
+
+// assignment2 --generate [events] [seed] [file prefix]
+// Writes <prefix>users.dat, <prefix>events.dat and <prefix>events.bin.
+int runWorkloadGenerator(const WorkloadOptions& options, const string& prefix);